@@ -1171,6 +1171,7 @@ void avatar::set_movement_mode( character_movemode new_mode )
     if( move_mode == CMM_CROUCH || new_mode == CMM_CROUCH ) {
         // crouching affects visibility
         get_map().set_seen_cache_dirty( pos().z );
+        Creature::invalidate_sight_cache();
     }
     move_mode = new_mode;
 }
@@ -17,6 +17,10 @@ bool fov_3d;
 bool static_z_effect = false;
 bool overmap_transparency = true;
 int fov_3d_z_range;
+bool parallel_map_cache = false;
+int mapbuffer_submap_limit = 0;
+bool prefetch_submaps = true;
+bool pregenerate_map = false;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
@@ -59,6 +59,18 @@ extern bool fov_3d;
 /** 3D FoV range, in Z levels, in both directions. */
 extern int fov_3d_z_range;
 
+/** Build per z-level map caches on the shared thread pool. */
+extern bool parallel_map_cache;
+
+/** Number of submaps kept in memory before distant ones are written out, 0 for no limit. */
+extern int mapbuffer_submap_limit;
+
+/** Read map quads ahead of the player's travel direction in the background. */
+extern bool prefetch_submaps;
+
+/** Run mapgen on the main thread for one unvisited map quad ahead of the player per turn. */
+extern bool pregenerate_map;
+
 /** Using isometric tileset. */
 extern bool tile_iso;
 
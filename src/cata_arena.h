@@ -1,36 +1,162 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "safe_reference.h"
 
+/** Allocation counters of a @ref cata_arena. */
+struct cata_arena_stats {
+    /** Objects allocated from the pool since the start. */
+    uint64_t allocations = 0;
+    /** Objects returned to the pool since the start. */
+    uint64_t releases = 0;
+    /** Objects currently allocated, including those pending destruction. */
+    uint64_t live = 0;
+    /** Highest value @ref live has had. */
+    uint64_t peak_live = 0;
+    /** Objects destroyed in game but not yet deleted. */
+    uint64_t pending = 0;
+    /** Slabs of slots the pool has grabbed from the heap. */
+    uint64_t slabs = 0;
+    /** Allocations of an unexpected size that went to the heap instead. */
+    uint64_t heap_fallbacks = 0;
+};
+
+/**
+ * Storage for game objects of type T.
+ *
+ * Objects are allocated from slabs of fixed-size slots and freed slots are
+ * reused through a free list, so churning objects doesn't hit the general heap.
+ * Objects destroyed in game are only deleted on the next @ref cleanup, so that
+ * references to them stay valid until the end of the turn. The pending objects
+ * are chained through their slots, which makes deferring a deletion O(1).
+ *
+ * T opts in by forwarding its class operator new and delete to
+ * @ref allocate and @ref deallocate. Only objects allocated that way may be
+ * passed to @ref mark_for_destruction.
+ */
 template <typename T>
 class cata_arena
 {
     private:
-        std::set<T *> pending_deletion;
+        struct slot {
+            /** Next slot in the free list or in the pending list. */
+            slot *next = nullptr;
+            bool pending = false;
+            alignas( T ) std::byte storage[sizeof( T )];
+        };
+
+        /** Number of slots grabbed from the heap at once. */
+        static constexpr size_t slab_slots = 128;
+
+        struct on_exit_cleanup {
+            cata_arena<T> &arena;
+            ~on_exit_cleanup() {
+                while( arena.cleanup_internal() ) {}
+            }
+        };
+
+        std::mutex mutex;
+        std::vector<std::unique_ptr<slot[]>> slabs;
+        slot *free_slots = nullptr;
+        slot *pending_deletion = nullptr;
+        cata_arena_stats stats;
 
         static cata_arena<T> &get_instance() {
-            static cata_arena<T> instance;
+            // Deliberately leaked: objects owned by other statics may be deleted after this
+            // function's statics are destroyed, and their slots have to stay valid until then.
+            // The slabs are returned to the OS at exit.
+            static cata_arena<T> &instance = *new cata_arena<T>();
+            // Deletes objects still pending at exit, like the destructor of a static arena would
+            static const on_exit_cleanup cleanup_at_exit{ instance };
             return instance;
         }
 
+        static slot *slot_of( void *ptr ) {
+            return reinterpret_cast<slot *>( static_cast<std::byte *>( ptr ) - offsetof( slot, storage ) );
+        }
+
+        void *allocate_internal( size_t size ) {
+            std::lock_guard<std::mutex> lk( mutex );
+            if( size != sizeof( T ) ) {
+                stats.heap_fallbacks++;
+                return ::operator new( size );
+            }
+            if( free_slots == nullptr ) {
+                slabs.push_back( std::make_unique<slot[]>( slab_slots ) );
+                stats.slabs++;
+                slot *slab = slabs.back().get();
+                for( size_t i = slab_slots; i > 0; i-- ) {
+                    slab[i - 1].next = free_slots;
+                    free_slots = &slab[i - 1];
+                }
+            }
+            slot *s = free_slots;
+            free_slots = s->next;
+            s->next = nullptr;
+            s->pending = false;
+            stats.allocations++;
+            stats.live++;
+            if( stats.live > stats.peak_live ) {
+                stats.peak_live = stats.live;
+            }
+            return s->storage;
+        }
+
+        void deallocate_internal( void *ptr, size_t size ) {
+            if( size != sizeof( T ) ) {
+                ::operator delete( ptr );
+                return;
+            }
+            std::lock_guard<std::mutex> lk( mutex );
+            slot *s = slot_of( ptr );
+            s->pending = false;
+            s->next = free_slots;
+            free_slots = s;
+            stats.releases++;
+            stats.live--;
+        }
+
         void mark_for_destruction_internal( T *alloc ) {
-            pending_deletion.insert( alloc );
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                slot *s = slot_of( alloc );
+                if( !s->pending ) {
+                    s->pending = true;
+                    s->next = pending_deletion;
+                    pending_deletion = s;
+                    stats.pending++;
+                }
+            }
             safe_reference<T>::mark_destroyed( alloc );
             cache_reference<T>::mark_destroyed( alloc );
         }
 
         bool cleanup_internal() {
-            if( pending_deletion.empty() ) {
+            slot *pending;
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                pending = pending_deletion;
+                pending_deletion = nullptr;
+                stats.pending = 0;
+            }
+            if( pending == nullptr ) {
                 return false;
             }
-            std::set<T *> dcopy = std::set<T *>( pending_deletion );
-            pending_deletion.clear();
-            for( T * const &p : dcopy ) {
+            // Deleting an object may mark more for destruction, those are left for the next call
+            while( pending != nullptr ) {
+                slot *next = pending->next;
+                T *p = std::launder( reinterpret_cast<T *>( pending->storage ) );
                 safe_reference<T>::mark_deallocated( p );
                 delete p;
+                pending = next;
             }
             return true;
         }
@@ -43,6 +169,16 @@ class cata_arena
 
         using value_type = T;
 
+        static void *allocate( size_t size ) {
+            return get_instance().allocate_internal( size );
+        }
+
+        static void deallocate( void *ptr, size_t size ) {
+            if( ptr != nullptr ) {
+                get_instance().deallocate_internal( ptr, size );
+            }
+        }
+
         static void mark_for_destruction( T *alloc ) {
             get_instance().mark_for_destruction_internal( alloc );
         }
@@ -51,8 +187,10 @@ class cata_arena
             return get_instance().cleanup_internal();
         }
 
-        ~cata_arena() {
-            while( cleanup_internal() ) {}
+        static cata_arena_stats get_stats() {
+            cata_arena<T> &instance = get_instance();
+            std::lock_guard<std::mutex> lk( instance.mutex );
+            return instance.stats;
         }
 };
 
@@ -10432,6 +10432,8 @@ void Character::on_item_wear( const item &it )
         }
     }
     morale->on_item_wear( it );
+    // Worn gear may hide the wearer
+    Creature::invalidate_sight_cache();
 }
 
 void Character::on_item_takeoff( const item &it )
@@ -10445,6 +10447,7 @@ void Character::on_item_takeoff( const item &it )
         }
     }
     morale->on_item_takeoff( it );
+    Creature::invalidate_sight_cache();
 }
 
 void Character::on_effect_int_change( const efftype_id &effect_type, int intensity,
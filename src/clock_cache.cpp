@@ -0,0 +1,174 @@
+#include "clock_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "point.h"
+
+template<typename Key, typename Value>
+size_t clock_cache<Key, Value>::bucket_of( const Key &key ) const
+{
+    // Fibonacci hashing, std::hash of points leaves the low bits poorly mixed
+    return static_cast<uint64_t>( std::hash<Key>()( key ) ) * 11400714819323198485ULL >> index_shift;
+}
+
+template<typename Key, typename Value>
+size_t clock_cache<Key, Value>::find_slot( const Key &key ) const
+{
+    const size_t mask = index.size() - 1;
+    size_t slot = bucket_of( key );
+    while( index[slot] != no_entry && !( entries[index[slot]].key == key ) ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+template<typename Key, typename Value>
+void clock_cache<Key, Value>::erase_slot( size_t slot )
+{
+    // Backward shift deletion: pull later entries of the probe sequence into the hole,
+    // so lookups never have to step over removed slots
+    const size_t mask = index.size() - 1;
+    size_t hole = slot;
+    for( size_t next = ( hole + 1 ) & mask; index[next] != no_entry; next = ( next + 1 ) & mask ) {
+        const size_t home = bucket_of( entries[index[next]].key );
+        if( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) ) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole] = no_entry;
+}
+
+template<typename Key, typename Value>
+uint32_t clock_cache<Key, Value>::take_victim()
+{
+    while( true ) {
+        entry &candidate = entries[hand];
+        const uint32_t victim = static_cast<uint32_t>( hand );
+        hand = ( hand + 1 ) % capacity;
+        if( !candidate.used ) {
+            return victim;
+        }
+        if( candidate.referenced ) {
+            candidate.referenced = false;
+            continue;
+        }
+        erase_slot( find_slot( candidate.key ) );
+        candidate.used = false;
+        count--;
+        stats.evictions++;
+        return victim;
+    }
+}
+
+template<typename Key, typename Value>
+Value clock_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
+{
+    if( count == 0 ) {
+        stats.misses++;
+        return default_;
+    }
+    const uint32_t found = index[find_slot( pos )];
+    if( found == no_entry ) {
+        stats.misses++;
+        return default_;
+    }
+    stats.hits++;
+    entries[found].referenced = true;
+    return entries[found].value;
+}
+
+template<typename Key, typename Value>
+void clock_cache<Key, Value>::remove( const Key &pos )
+{
+    if( count == 0 ) {
+        return;
+    }
+    const size_t slot = find_slot( pos );
+    const uint32_t found = index[slot];
+    if( found == no_entry ) {
+        return;
+    }
+    erase_slot( slot );
+    entries[found] = entry();
+    free_entries.push_back( found );
+    count--;
+}
+
+template<typename Key, typename Value>
+void clock_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t )
+{
+    if( limit <= 0 ) {
+        clear();
+        return;
+    }
+    if( limit != capacity ) {
+        resize( limit );
+    }
+
+    size_t slot = find_slot( pos );
+    if( index[slot] != no_entry ) {
+        entry &existing = entries[index[slot]];
+        existing.value = t;
+        existing.referenced = true;
+        return;
+    }
+
+    uint32_t target;
+    if( !free_entries.empty() ) {
+        target = free_entries.back();
+        free_entries.pop_back();
+    } else {
+        target = take_victim();
+        // Evicting may have shifted the probe sequence of the new key
+        slot = find_slot( pos );
+    }
+    entries[target].key = pos;
+    entries[target].value = t;
+    entries[target].used = true;
+    entries[target].referenced = false;
+    index[slot] = target;
+    count++;
+}
+
+template<typename Key, typename Value>
+void clock_cache<Key, Value>::resize( int limit )
+{
+    capacity = limit;
+    size_t index_size = 1;
+    index_shift = 64;
+    // Keep the index at most half full, probe sequences stay short
+    while( index_size < static_cast<size_t>( limit ) * 2 ) {
+        index_size *= 2;
+        index_shift--;
+    }
+    entries.assign( limit, entry() );
+    index.assign( index_size, no_entry );
+    free_entries.clear();
+    free_entries.reserve( limit );
+    count = 0;
+    clear();
+}
+
+template<typename Key, typename Value>
+void clock_cache<Key, Value>::clear()
+{
+    if( capacity == 0 || ( count == 0 && free_entries.size() == static_cast<size_t>( capacity ) ) ) {
+        return;
+    }
+    if( count != 0 ) {
+        std::fill( index.begin(), index.end(), no_entry );
+        std::fill( entries.begin(), entries.end(), entry() );
+    }
+    free_entries.clear();
+    for( int i = capacity - 1; i >= 0; i-- ) {
+        free_entries.push_back( i );
+    }
+    count = 0;
+    hand = 0;
+}
+
+// explicit template initialization for clock_cache of all types
+template class clock_cache<tripoint, int>;
+template class clock_cache<point, char>;
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "enums.h" // IWYU pragma: keep
+
+struct cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    /** Entries dropped to make room for new ones. */
+    uint64_t evictions = 0;
+};
+
+/**
+ * Fixed-capacity replacement for @ref lru_cache, for caches on hot paths.
+ *
+ * Entries live in one array and are found through an open-addressing index, so
+ * nothing is allocated per insert. Once full, CLOCK picks the entry to evict:
+ * entries that were read or written since the clock hand last passed them get
+ * another round, so the eviction order approximates least recently used.
+ *
+ * Storage is sized for the limit given to the first insert, and reallocated
+ * (dropping all entries) only if a later insert asks for a different limit.
+ */
+template<typename Key, typename Value>
+class clock_cache
+{
+    public:
+        void insert( int limit, const Key &, const Value & );
+        Value get( const Key &, const Value &default_ ) const;
+        void remove( const Key & );
+
+        void clear();
+        size_t size() const {
+            return count;
+        }
+
+        const cache_stats &get_stats() const {
+            return stats;
+        }
+        void reset_stats() {
+            stats = cache_stats();
+        }
+    private:
+        static constexpr uint32_t no_entry = UINT32_MAX;
+
+        struct entry {
+            Key key;
+            Value value;
+            bool used = false;
+            mutable bool referenced = false;
+        };
+
+        void resize( int limit );
+        size_t bucket_of( const Key &key ) const;
+        /** Index slot that refers to @p key, or to no entry if it isn't cached. */
+        size_t find_slot( const Key &key ) const;
+        void erase_slot( size_t slot );
+        uint32_t take_victim();
+
+        std::vector<entry> entries;
+        /** Open-addressing index into @ref entries, linear probing. */
+        std::vector<uint32_t> index;
+        /** Entries that don't hold anything. */
+        std::vector<uint32_t> free_entries;
+        int capacity = 0;
+        size_t count = 0;
+        size_t hand = 0;
+        int index_shift = 64;
+        mutable cache_stats stats;
+};
@@ -575,8 +575,70 @@ bool zone_manager::has_type( const zone_type_id &type ) const
 
 bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    return type_iter != area_cache.end();
+    return area_cache.contains( area_key( type, fac ) );
+}
+
+void zone_area_index::add( const tripoint &start, const tripoint &end )
+{
+    boxes.emplace_back( start, end );
+}
+
+bool zone_area_index::contains( const tripoint &p ) const
+{
+    return std::ranges::any_of( boxes, [&p]( const std::pair<tripoint, tripoint> &box ) {
+        return p.x >= box.first.x && p.x <= box.second.x &&
+               p.y >= box.first.y && p.y <= box.second.y &&
+               p.z >= box.first.z && p.z <= box.second.z;
+    } );
+}
+
+bool zone_area_index::has_near( const tripoint &where, int range ) const
+{
+    return std::ranges::any_of( boxes, [&]( const std::pair<tripoint, tripoint> &box ) {
+        return where.z >= box.first.z && where.z <= box.second.z &&
+               std::max( box.first.x, where.x - range ) <= std::min( box.second.x, where.x + range ) &&
+               std::max( box.first.y, where.y - range ) <= std::min( box.second.y, where.y + range );
+    } );
+}
+
+void zone_area_index::get_near( const tripoint &where, int range,
+                                std::unordered_set<tripoint> &out ) const
+{
+    for( const std::pair<tripoint, tripoint> &box : boxes ) {
+        if( where.z < box.first.z || where.z > box.second.z ) {
+            continue;
+        }
+        const int min_x = std::max( box.first.x, where.x - range );
+        const int max_x = std::min( box.second.x, where.x + range );
+        const int min_y = std::max( box.first.y, where.y - range );
+        const int max_y = std::min( box.second.y, where.y + range );
+        for( int y = min_y; y <= max_y; y++ ) {
+            for( int x = min_x; x <= max_x; x++ ) {
+                out.emplace( x, y, where.z );
+            }
+        }
+    }
+}
+
+std::optional<tripoint> zone_area_index::get_nearest( const tripoint &where, int range ) const
+{
+    std::optional<tripoint> nearest;
+    int nearest_dist = range + 1;
+    for( const std::pair<tripoint, tripoint> &box : boxes ) {
+        if( box.first.x > box.second.x || box.first.y > box.second.y || box.first.z > box.second.z ) {
+            continue;
+        }
+        // The closest square of a box is the query point clamped into it
+        const tripoint p( clamp( where.x, box.first.x, box.second.x ),
+                          clamp( where.y, box.first.y, box.second.y ),
+                          clamp( where.z, box.first.z, box.second.z ) );
+        const int dist = square_dist( p, where );
+        if( dist < nearest_dist ) {
+            nearest_dist = dist;
+            nearest = p;
+        }
+    }
+    return nearest;
 }
 
 void zone_manager::cache_data()
@@ -587,15 +649,8 @@ void zone_manager::cache_data()
         if( !elem.get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem.get_start_point(),
-                elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        area_cache[area_key( elem.get_type(), elem.get_faction() )].add( elem.get_start_point(),
+                elem.get_end_point() );
     }
 }
 
@@ -607,26 +662,18 @@ void zone_manager::cache_vzones()
         if( !elem->get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
-
-        // TODO: looks very similar to the above cache_data - maybe merge it?
-
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem->get_start_point(),
-                elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
+        vzone_cache[area_key( elem->get_type(), elem->get_faction() )].add( elem->get_start_point(),
+                elem->get_end_point() );
     }
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
+const zone_area_index &zone_manager::get_point_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
+    static const zone_area_index empty;
+    const auto &type_iter = area_cache.find( area_key( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return empty;
     }
 
     return type_iter->second;
@@ -657,13 +704,14 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
+const zone_area_index &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
+    static const zone_area_index empty;
     //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
+    const auto &type_iter = vzone_cache.find( area_key( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return empty;
     }
 
     return type_iter->second;
@@ -672,33 +720,15 @@ std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &ty
 bool zone_manager::has( const zone_type_id &type, const tripoint &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    return get_point_set( type, fac ).contains( where ) ||
+           get_vzone_set( type, fac ).contains( where );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return get_point_set( type, fac ).has_near( where, range ) ||
+           get_vzone_set( type, fac ).has_near( where, range );
 }
 
 bool zone_manager::has_loot_dest_near( const tripoint &where ) const
@@ -734,52 +764,66 @@ const zone_data *zone_manager::get_zone_at( const tripoint &where, const zone_ty
     return nullptr;
 }
 
+const std::function<bool( const item & )> &zone_manager::get_loot_filter(
+    const zone_data &zone ) const
+{
+    const loot_options &options = dynamic_cast<const loot_options &>( zone.get_options() );
+    std::string filter_string = options.get_mark();
+    auto iter = loot_filter_cache.find( filter_string );
+    if( iter == loot_filter_cache.end() ) {
+        auto filter = item_filter_from_string( filter_string );
+        iter = loot_filter_cache.emplace( std::move( filter_string ), std::move( filter ) ).first;
+    }
+    return iter->second;
+}
+
 bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) const
 {
     auto zone = get_zone_at( where, zone_LOOT_CUSTOM );
     if( !zone || !it ) {
         return false;
     }
-    const loot_options &options = dynamic_cast<const loot_options &>( zone->get_options() );
-    std::string filter_string = options.get_mark();
-    auto z = item_filter_from_string( filter_string );
-
-    return z( *it );
+    return get_loot_filter( *zone )( *it );
 }
 
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint>();
+    get_point_set( type, fac ).get_near( where, range, near_point_set );
+    get_vzone_set( type, fac ).get_near( where, range, near_point_set );
+    if( !it || near_point_set.empty() || !has_near( zone_LOOT_CUSTOM, where, range ) ) {
+        return near_point_set;
+    }
 
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
-            }
+    // Squares in a custom loot zone only take items matching the filter of the first
+    // custom zone there, so match the item against each custom zone once.
+    std::vector<std::pair<const zone_data *, std::optional<bool>>> custom_zones;
+    for( const zone_data &zone : zones ) {
+        if( zone.get_type() == zone_LOOT_CUSTOM ) {
+            custom_zones.emplace_back( &zone, std::nullopt );
         }
     }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
+    for( const zone_data *zone : get_map().get_vehicle_zones( g->get_levz() ) ) {
+        if( zone->get_type() == zone_LOOT_CUSTOM ) {
+            custom_zones.emplace_back( zone, std::nullopt );
+        }
+    }
+    for( auto iter = near_point_set.begin(); iter != near_point_set.end(); ) {
+        bool keep = true;
+        if( has( zone_LOOT_CUSTOM, *iter ) ) {
+            keep = false;
+            for( auto &custom : custom_zones ) {
+                if( custom.first->has_inside( *iter ) ) {
+                    if( !custom.second ) {
+                        custom.second = get_loot_filter( *custom.first )( *it );
                     }
-                } else {
-                    near_point_set.insert( point );
+                    keep = *custom.second;
+                    break;
                 }
             }
         }
+        iter = keep ? std::next( iter ) : near_point_set.erase( iter );
     }
 
     return near_point_set;
@@ -792,35 +836,15 @@ std::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, con
         return std::nullopt;
     }
 
-    tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
-    int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
+    std::optional<tripoint> nearest = get_point_set( type, fac ).get_nearest( where, range );
+    const int nearest_range = nearest ? square_dist( *nearest, where ) - 1 : range;
+    if( nearest_range >= 0 ) {
+        if( std::optional<tripoint> vzone = get_vzone_set( type, fac ).get_nearest( where,
+                                            nearest_range ) ) {
+            nearest = vzone;
         }
     }
-    if( nearest_dist > range ) {
-        return std::nullopt;
-    }
-    return nearest_pos;
+    return nearest;
 }
 
 zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
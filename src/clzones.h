@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "hash_utils.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "string_id.h"
@@ -334,6 +335,28 @@ class zone_data
         void deserialize( JsonIn &jsin );
 };
 
+/**
+ * Squares covered by the enabled zones of one type and faction.
+ * Kept as the zone boxes themselves: a base has far fewer zones than squares,
+ * so lookups walk the boxes near the query instead of every covered square.
+ */
+class zone_area_index
+{
+    public:
+        void add( const tripoint &start, const tripoint &end );
+        bool contains( const tripoint &p ) const;
+        /** Whether a covered square on the z-level of @p where is within @p range of it. */
+        bool has_near( const tripoint &where, int range ) const;
+        /** Adds covered squares on the z-level of @p where within @p range of it to @p out. */
+        void get_near( const tripoint &where, int range, std::unordered_set<tripoint> &out ) const;
+        /** Covered square closest to @p where on any z-level, if any is within @p range. */
+        std::optional<tripoint> get_nearest( const tripoint &where, int range ) const;
+
+    private:
+        /** Inclusive corners of the zones, as stored in @ref zone_data */
+        std::vector<std::pair<tripoint, tripoint>> boxes;
+};
+
 class zone_manager
 {
     public:
@@ -352,12 +375,16 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
+        using area_key = std::pair<zone_type_id, faction_id>;
+        std::unordered_map<area_key, zone_area_index, cata::tuple_hash> area_cache;
+        std::unordered_map<area_key, zone_area_index, cata::tuple_hash> vzone_cache;
+        const zone_area_index &get_point_set( const zone_type_id &type,
+                                              const faction_id &fac = your_fac ) const;
+        const zone_area_index &get_vzone_set( const zone_type_id &type,
+                                              const faction_id &fac = your_fac ) const;
+        /** Parsed custom loot filters by filter string */
+        mutable std::unordered_map<std::string, std::function<bool( const item & )>> loot_filter_cache;
+        const std::function<bool( const item & )> &get_loot_filter( const zone_data &zone ) const;
 
         //Cache number of items already checked on each source tile when sorting
         std::unordered_map<tripoint, int> num_processed;
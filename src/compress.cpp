@@ -1,6 +1,9 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -50,4 +53,257 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+
+/**
+ * LZ4 block format, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ *
+ * The compressor is the plain greedy one with a single hash table probe per position,
+ * which is what makes LZ4 fast.  The decompressor accepts any valid block.
+ */
+namespace
+{
+
+constexpr size_t lz4_header_size = 4;
+constexpr size_t lz4_min_match = 4;
+// The last match must start at least 12 bytes before the end of the block,
+// and the last 5 bytes are always literals.
+constexpr size_t lz4_match_start_limit = 12;
+constexpr size_t lz4_last_literals = 5;
+constexpr size_t lz4_max_offset = 65535;
+// Larger than any blob the game writes, anything above is a corrupted header
+constexpr size_t lz4_max_uncompressed_size = size_t( 256 ) * 1024 * 1024;
+// A sequence can't expand to more than 255 bytes per byte of block
+constexpr size_t lz4_max_ratio = 255;
+constexpr int lz4_hash_bits = 12;
+
+uint32_t read_u32( const unsigned char *p )
+{
+    uint32_t v;
+    std::memcpy( &v, p, sizeof( v ) );
+    return v;
+}
+
+uint32_t lz4_hash( uint32_t sequence )
+{
+    return ( sequence * 2654435761U ) >> ( 32 - lz4_hash_bits );
+}
+
+void lz4_write_length( std::vector<std::byte> &output, size_t length )
+{
+    while( length >= 255 ) {
+        output.push_back( std::byte{ 255 } );
+        length -= 255;
+    }
+    output.push_back( static_cast<std::byte>( length ) );
+}
+
+void lz4_write_sequence( std::vector<std::byte> &output, const unsigned char *literals,
+                         size_t literal_length, size_t offset, size_t match_length )
+{
+    const size_t match_code = match_length == 0 ? 0 : match_length - lz4_min_match;
+    const unsigned char token = static_cast<unsigned char>(
+                                    ( std::min<size_t>( literal_length, 15 ) << 4 ) | std::min<size_t>( match_code, 15 ) );
+    output.push_back( static_cast<std::byte>( token ) );
+    if( literal_length >= 15 ) {
+        lz4_write_length( output, literal_length - 15 );
+    }
+    const size_t literal_pos = output.size();
+    output.resize( literal_pos + literal_length );
+    if( literal_length > 0 ) {
+        std::memcpy( output.data() + literal_pos, literals, literal_length );
+    }
+    if( match_length == 0 ) {
+        return;
+    }
+    output.push_back( static_cast<std::byte>( offset & 0xFF ) );
+    output.push_back( static_cast<std::byte>( offset >> 8 ) );
+    if( match_code >= 15 ) {
+        lz4_write_length( output, match_code - 15 );
+    }
+}
+
+size_t lz4_read_length( const unsigned char *in, size_t size, size_t &ip )
+{
+    size_t length = 0;
+    unsigned char b;
+    do {
+        if( ip >= size ) {
+            throw std::runtime_error( "LZ4 decompression failed: truncated length" );
+        }
+        b = in[ip++];
+        length += b;
+    } while( b == 255 );
+    return length;
+}
+
+} // namespace
+
+void lz4_compress( const std::string &input, std::vector<std::byte> &output )
+{
+    const size_t size = input.size();
+    if( size > lz4_max_uncompressed_size ) {
+        throw std::runtime_error( "LZ4 compression error: input too large" );
+    }
+    output.clear();
+    output.reserve( lz4_header_size + size + size / 255 + 16 );
+    for( size_t i = 0; i < lz4_header_size; i++ ) {
+        output.push_back( static_cast<std::byte>( ( size >> ( 8 * i ) ) & 0xFF ) );
+    }
+
+    const unsigned char *in = reinterpret_cast<const unsigned char *>( input.data() );
+    size_t anchor = 0;
+    if( size > lz4_match_start_limit ) {
+        // Positions are stored off by one, so 0 means empty
+        std::vector<uint32_t> table( size_t( 1 ) << lz4_hash_bits, 0 );
+        const size_t match_start_end = size - lz4_match_start_limit;
+        const size_t match_end = size - lz4_last_literals;
+        size_t ip = 0;
+        while( ip < match_start_end ) {
+            const uint32_t sequence = read_u32( in + ip );
+            uint32_t &slot = table[lz4_hash( sequence )];
+            const size_t ref = slot;
+            slot = static_cast<uint32_t>( ip + 1 );
+            if( ref == 0 || ip - ( ref - 1 ) > lz4_max_offset || read_u32( in + ref - 1 ) != sequence ) {
+                ip++;
+                continue;
+            }
+            const size_t match_pos = ref - 1;
+            size_t length = lz4_min_match;
+            while( ip + length < match_end && in[match_pos + length] == in[ip + length] ) {
+                length++;
+            }
+            lz4_write_sequence( output, in + anchor, ip - anchor, ip - match_pos, length );
+            ip += length;
+            anchor = ip;
+        }
+    }
+    lz4_write_sequence( output, in + anchor, size - anchor, 0, 0 );
+}
+
+void lz4_decompress( const void *compressed_data, size_t compressed_size, std::string &output )
+{
+    const unsigned char *in = static_cast<const unsigned char *>( compressed_data );
+    if( compressed_size < lz4_header_size + 1 ) {
+        throw std::runtime_error( "LZ4 decompression failed: truncated header" );
+    }
+    size_t expected = 0;
+    for( size_t i = 0; i < lz4_header_size; i++ ) {
+        expected |= static_cast<size_t>( in[i] ) << ( 8 * i );
+    }
+    if( expected > lz4_max_uncompressed_size ||
+        expected > ( compressed_size - lz4_header_size ) * lz4_max_ratio ) {
+        throw std::runtime_error( "LZ4 decompression failed: stored length out of bounds" );
+    }
+    output.resize( expected );
+    char *out = output.data();
+
+    size_t ip = lz4_header_size;
+    size_t op = 0;
+    while( true ) {
+        if( ip >= compressed_size ) {
+            throw std::runtime_error( "LZ4 decompression failed: truncated sequence" );
+        }
+        const unsigned char token = in[ip++];
+        size_t literal_length = token >> 4;
+        if( literal_length == 15 ) {
+            literal_length += lz4_read_length( in, compressed_size, ip );
+        }
+        if( literal_length > compressed_size - ip || literal_length > expected - op ) {
+            throw std::runtime_error( "LZ4 decompression failed: literals out of bounds" );
+        }
+        std::memcpy( out + op, in + ip, literal_length );
+        ip += literal_length;
+        op += literal_length;
+        if( ip == compressed_size ) {
+            break;
+        }
+
+        if( compressed_size - ip < 2 ) {
+            throw std::runtime_error( "LZ4 decompression failed: truncated offset" );
+        }
+        const size_t offset = in[ip] | ( static_cast<size_t>( in[ip + 1] ) << 8 );
+        ip += 2;
+        size_t match_length = token & 0x0F;
+        if( match_length == 15 ) {
+            match_length += lz4_read_length( in, compressed_size, ip );
+        }
+        match_length += lz4_min_match;
+        if( offset == 0 || offset > op || match_length > expected - op ) {
+            throw std::runtime_error( "LZ4 decompression failed: match out of bounds" );
+        }
+        const char *match = out + op - offset;
+        if( offset >= match_length ) {
+            std::memcpy( out + op, match, match_length );
+        } else {
+            // Overlapping match repeats the last offset bytes
+            for( size_t i = 0; i < match_length; i++ ) {
+                out[op + i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+    if( op != expected ) {
+        throw std::runtime_error( "LZ4 decompression failed: size mismatch" );
+    }
+}
+
+std::string compression_codec_name( compression_codec codec )
+{
+    switch( codec ) {
+        case compression_codec::none:
+            return "";
+        case compression_codec::zlib:
+            return "zlib";
+        case compression_codec::lz4:
+            return "lz4";
+    }
+    return "";
+}
+
+std::optional<compression_codec> compression_codec_from_name( const std::string &name )
+{
+    for( compression_codec codec : {
+             compression_codec::none, compression_codec::zlib, compression_codec::lz4
+         } ) {
+        if( compression_codec_name( codec ) == name ) {
+            return codec;
+        }
+    }
+    return std::nullopt;
+}
+
+void compress_blob( compression_codec codec, const std::string &input,
+                    std::vector<std::byte> &output )
+{
+    switch( codec ) {
+        case compression_codec::none:
+            output.resize( input.size() );
+            if( !input.empty() ) {
+                std::memcpy( output.data(), input.data(), input.size() );
+            }
+            return;
+        case compression_codec::zlib:
+            zlib_compress( input, output );
+            return;
+        case compression_codec::lz4:
+            lz4_compress( input, output );
+            return;
+    }
+}
+
+void decompress_blob( compression_codec codec, const void *compressed_data, size_t compressed_size,
+                      std::string &output )
+{
+    switch( codec ) {
+        case compression_codec::none:
+            output.assign( static_cast<const char *>( compressed_data ), compressed_size );
+            return;
+        case compression_codec::zlib:
+            zlib_decompress( compressed_data, static_cast<int>( compressed_size ), output );
+            return;
+        case compression_codec::lz4:
+            lz4_decompress( compressed_data, compressed_size, output );
+            return;
+    }
+}
@@ -1,10 +1,35 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "fstream_utils.h"
 
 void zlib_compress( const std::string &input, std::vector<std::byte> &output );
 void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output );
 
+/**
+ * LZ4 block compression. The output starts with the uncompressed length as a 32 bit
+ * little endian integer, so decompression can size its buffer up front.
+ */
+void lz4_compress( const std::string &input, std::vector<std::byte> &output );
+void lz4_decompress( const void *compressed_data, size_t compressed_size, std::string &output );
 
+/** Compression applied to blobs stored in save databases. */
+enum class compression_codec : int {
+    none,
+    zlib,
+    lz4,
+};
+
+/** Name of the codec as stored alongside each blob, empty for @ref compression_codec::none. */
+std::string compression_codec_name( compression_codec codec );
+/** Inverse of @ref compression_codec_name, or nothing if @p name is not a known codec. */
+std::optional<compression_codec> compression_codec_from_name( const std::string &name );
+
+void compress_blob( compression_codec codec, const std::string &input,
+                    std::vector<std::byte> &output );
+void decompress_blob( compression_codec codec, const void *compressed_data, size_t compressed_size,
+                      std::string &output );
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 
 #include "anatomy.h"
 #include "avatar.h"
@@ -23,6 +24,7 @@
 #include "field.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "int_id.h"
 #include "item.h"
 #include "json.h"
@@ -263,6 +265,53 @@ bool Creature::is_dangerous_field( const field_entry &entry ) const
     return entry.is_dangerous() && !is_immune_field( entry.get_field_type() );
 }
 
+namespace
+{
+
+struct sight_cache_key {
+    const Creature *observer;
+    const Creature *target;
+    tripoint observer_pos;
+    tripoint target_pos;
+
+    bool operator==( const sight_cache_key & ) const = default;
+};
+
+struct sight_cache_key_hash {
+    size_t operator()( const sight_cache_key &key ) const {
+        size_t seed = std::hash<const Creature *>()( key.observer );
+        cata::hash_combine( seed, key.target );
+        cata::hash_combine( seed, key.observer_pos );
+        cata::hash_combine( seed, key.target_pos );
+        return seed;
+    }
+};
+
+struct sight_cache {
+    std::unordered_map<sight_cache_key, bool, sight_cache_key_hash> results;
+    time_point turn;
+    bool valid = false;
+};
+
+sight_cache &get_sight_cache()
+{
+    static sight_cache cache;
+    if( !cache.valid || cache.turn != calendar::turn ) {
+        // Keeps the buckets, the next turn asks about mostly the same creatures
+        cache.results.clear();
+        cache.turn = calendar::turn;
+        cache.valid = true;
+    }
+    return cache;
+}
+
+} // namespace
+
+void Creature::invalidate_sight_cache()
+{
+    get_sight_cache().valid = false;
+}
+
 bool Creature::sees( const Creature &critter ) const
 {
     ZoneScoped;
@@ -279,6 +328,19 @@ bool Creature::sees( const Creature &critter ) const
         return is_player();
     }
 
+    // monster::plan, the sidebar and NPC AI ask about the same pairs many times each turn
+    sight_cache &cache = get_sight_cache();
+    const sight_cache_key key{ this, &critter, pos(), critter.pos() };
+    if( const auto it = cache.results.find( key ); it != cache.results.end() ) {
+        return it->second;
+    }
+    const bool result = sees_uncached( critter );
+    cache.results.emplace( key, result );
+    return result;
+}
+
+bool Creature::sees_uncached( const Creature &critter ) const
+{
     if( !fov_3d && !debug_mode && posz() != critter.posz() ) {
         return false;
     }
@@ -1198,6 +1260,7 @@ void Creature::add_effect( const efftype_id &eff_id, const time_duration &dur,
             e.set_intensity( e.get_max_intensity() );
         }
         ( *effects )[eff_id][bp] = e;
+        invalidate_sight_cache();
         if( Character *ch = as_character() ) {
             g->events().send<event_type::character_gains_effect>( ch->getID(), eff_id );
             if( is_player() && !type.get_apply_message().empty() ) {
@@ -1279,6 +1342,7 @@ bool Creature::remove_effect( const efftype_id &eff_id, const bodypart_str_id &b
         on_effect_int_change( e.get_id(), 0, e.get_bp() );
         e.set_removed();
     }
+    invalidate_sight_cache();
     // Sleep is a special case, since it affects max sight range and other effects
     // Must be below the set_removed above or we'll get an infinite loop
     if( ch != nullptr && eff_id == effect_sleep ) {
@@ -301,6 +301,15 @@ class Creature
         virtual bool sees( const tripoint &t, bool is_avatar = false, int range_mod = 0 ) const;
         /*@}*/
 
+        /**
+         * Results of @ref sees( const Creature & ) are remembered for the current turn, keyed
+         * by both creatures and their positions. Anything else that changes what creatures
+         * can see (rebuilt map and light caches, effects, movement modes, worn gear, player and
+         * NPC actions) must call this. Marking map caches dirty doesn't, sight is checked
+         * against the built caches until they are rebuilt.
+         */
+        static void invalidate_sight_cache();
+
         /**
          * How far the creature sees under the given light. Places outside this range can
          * @param light_level See @ref game::light_level.
@@ -1030,6 +1039,8 @@ class Creature
     private:
         int pain = 0;
         bool underwater = false;
+
+        bool sees_uncached( const Creature &critter ) const;
 };
 
 
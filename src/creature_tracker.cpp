@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -57,6 +59,8 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 {
     assert( critter_ptr );
     monster &critter = *critter_ptr;
+    // May have the address of a monster that is gone
+    Creature::invalidate_sight_cache();
 
     if( critter.type->id.is_null() ) { // Don't want to spawn null monsters o.O
         return false;
@@ -87,21 +91,146 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.pos()] = critter_ptr;
+    add_to_bucket( critter, critter.pos() );
     add_to_faction_map( critter_ptr );
     return true;
 }
 
+mfaction_id Creature_tracker::tracked_faction( const monster &critter )
+{
+    // Only 1 faction per mon at the moment.
+    if( critter.friendly == 0 ) {
+        return critter.faction;
+    }
+    static const mfaction_str_id playerfaction( "player" );
+    return playerfaction;
+}
+
 void Creature_tracker::add_to_faction_map( const shared_ptr_fast<monster> &critter_ptr )
 {
     assert( critter_ptr );
-    monster &critter = *critter_ptr;
+    monster_faction_map_[ tracked_faction( *critter_ptr ) ].insert( critter_ptr );
+}
 
-    // Only 1 faction per mon at the moment.
-    if( critter.friendly == 0 ) {
-        monster_faction_map_[ critter.faction ].insert( critter_ptr );
-    } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
+tripoint Creature_tracker::bucket_of( const tripoint &pos )
+{
+    return tripoint( divide_round_to_minus_infinity( pos.x, SEEX ),
+                     divide_round_to_minus_infinity( pos.y, SEEY ), pos.z );
+}
+
+void Creature_tracker::add_to_bucket( monster &critter, const tripoint &pos )
+{
+    remove_from_bucket( critter );
+    const tripoint key = bucket_of( pos );
+    monsters_by_bucket[key].push_back( &critter );
+    bucket_keys[&critter] = key;
+}
+
+void Creature_tracker::remove_from_bucket( const monster &critter )
+{
+    const auto key_iter = bucket_keys.find( &critter );
+    if( key_iter == bucket_keys.end() ) {
+        return;
+    }
+    const auto bucket_iter = monsters_by_bucket.find( key_iter->second );
+    if( bucket_iter != monsters_by_bucket.end() ) {
+        std::vector<monster *> &bucket = bucket_iter->second;
+        const auto iter = std::ranges::find( bucket, &critter );
+        if( iter != bucket.end() ) {
+            *iter = bucket.back();
+            bucket.pop_back();
+        }
+        if( bucket.empty() ) {
+            monsters_by_bucket.erase( bucket_iter );
+        }
+    }
+    bucket_keys.erase( key_iter );
+}
+
+template<typename Filter>
+std::vector<monster *> Creature_tracker::find_in_radius_if( const tripoint &center, int radius,
+        Filter filter ) const
+{
+    std::vector<monster *> result;
+    if( radius < 0 ) {
+        return result;
+    }
+    const auto add_matching = [&]( const std::vector<monster *> &bucket ) {
+        for( monster *critter : bucket ) {
+            const tripoint &p = critter->pos();
+            if( std::abs( p.x - center.x ) <= radius && std::abs( p.y - center.y ) <= radius &&
+                std::abs( p.z - center.z ) <= radius && !critter->is_dead() && filter( *critter ) ) {
+                result.push_back( critter );
+            }
+        }
+    };
+
+    const int min_z = std::max( center.z - std::min( radius, OVERMAP_LAYERS ), -OVERMAP_DEPTH );
+    const int max_z = std::min( center.z + std::min( radius, OVERMAP_LAYERS ), OVERMAP_HEIGHT );
+    const int64_t buckets_across = static_cast<int64_t>( radius ) * 2 / SEEX + 2;
+    const int64_t buckets_in_range = buckets_across * buckets_across * ( max_z - min_z + 1 );
+    if( buckets_in_range >= static_cast<int64_t>( monsters_by_bucket.size() ) ) {
+        // Cheaper to look at everything than to look up each bucket in range
+        for( const auto &pair : monsters_by_bucket ) {
+            add_matching( pair.second );
+        }
+        return result;
+    }
+
+    const tripoint min_bucket = bucket_of( center - point( radius, radius ) );
+    const tripoint max_bucket = bucket_of( center + point( radius, radius ) );
+    for( int z = min_z; z <= max_z; z++ ) {
+        for( int y = min_bucket.y; y <= max_bucket.y; y++ ) {
+            for( int x = min_bucket.x; x <= max_bucket.x; x++ ) {
+                const auto iter = monsters_by_bucket.find( tripoint( x, y, z ) );
+                if( iter != monsters_by_bucket.end() ) {
+                    add_matching( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, int radius ) const
+{
+    return find_in_radius_if( center, radius, []( const monster & ) {
+        return true;
+    } );
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, int radius,
+        const mfaction_id &faction ) const
+{
+    return find_in_radius_if( center, radius, [&faction]( const monster & critter ) {
+        return tracked_faction( critter ) == faction;
+    } );
+}
+
+std::vector<monster *> Creature_tracker::find_nearest( const tripoint &center, size_t count,
+        int max_radius ) const
+{
+    if( count == 0 ) {
+        return std::vector<monster *>();
+    }
+    // Grow the searched area until it surely contains the nearest monsters
+    for( int radius = std::min( SEEX, max_radius ); ; radius = radius >= max_radius / 2 ? max_radius : radius * 2 ) {
+        std::vector<monster *> found = find_in_radius( center, radius );
+        std::ranges::sort( found, [&center]( const monster * lhs, const monster * rhs ) {
+            return rl_dist( center, lhs->pos() ) < rl_dist( center, rhs->pos() );
+        } );
+        // rl_dist is never below the distance along any axis, so everything within
+        // `radius` of it has been found already
+        const auto first_unsure = std::ranges::find_if( found, [&]( const monster * critter ) {
+            return rl_dist( center, critter->pos() ) > radius;
+        } );
+        if( static_cast<size_t>( first_unsure - found.begin() ) >= count || radius >= max_radius ) {
+            found.erase( first_unsure, found.end() );
+            if( found.size() > count ) {
+                found.resize( count );
+            }
+            return found;
+        }
     }
 }
 
@@ -166,6 +295,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( critter.pos() );
         monsters_by_location[new_pos] = *iter;
+        add_to_bucket( **iter, new_pos );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -182,6 +312,8 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
 
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
+    remove_from_bucket( critter );
+
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
         monsters_by_location.erase( pos_iter );
@@ -228,6 +360,8 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_bucket.clear();
+    bucket_keys.clear();
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -235,9 +369,12 @@ void Creature_tracker::clear()
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_bucket.clear();
+    bucket_keys.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
         monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        add_to_bucket( *mon_ptr, mon_ptr->pos() );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -273,9 +410,11 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
         monsters_by_location[first.pos()] = first_ptr;
+        add_to_bucket( *first_ptr, first.pos() );
     }
     if( second_ptr ) {
         monsters_by_location[second.pos()] = second_ptr;
+        add_to_bucket( *second_ptr, second.pos() );
     }
 }
 
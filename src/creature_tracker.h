@@ -19,6 +19,8 @@ class Creature_tracker
     private:
 
         void add_to_faction_map( const shared_ptr_fast<monster> &critter );
+        /** Key of @p critter in @ref monster_faction_map_ */
+        static mfaction_id tracked_faction( const monster &critter );
 
         class weak_ptr_comparator
         {
@@ -91,9 +93,37 @@ class Creature_tracker
             return monster_faction_map_;
         }
 
+        /**
+         * Living monsters no farther than @p radius from @p center along each axis,
+         * z included, in no particular order. Callers check the exact distance they need.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius ) const;
+        /** Like @ref find_in_radius, but only monsters of @p faction, as grouped in @ref factions. */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius,
+                                               const mfaction_id &faction ) const;
+        /**
+         * Up to @p count living monsters closest to @p center by @ref rl_dist, nearest first.
+         * Monsters farther away than @p max_radius are not considered.
+         */
+        std::vector<monster *> find_nearest( const tripoint &center, size_t count,
+                                             int max_radius ) const;
+
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * Monsters grouped by the submap sized square of the map they are in, keyed by
+         * @ref bucket_of. Kept next to @ref monsters_by_location for area queries.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> monsters_by_bucket;
+        /** Bucket each monster in @ref monsters_by_bucket is filed under */
+        std::unordered_map<const monster *, tripoint> bucket_keys;
+        static tripoint bucket_of( const tripoint &pos );
+        void add_to_bucket( monster &critter, const tripoint &pos );
+        void remove_from_bucket( const monster &critter );
+        template<typename Filter>
+        std::vector<monster *> find_in_radius_if( const tripoint &center, int radius,
+                Filter filter ) const;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
@@ -27,7 +27,9 @@
 #include "artifact.h"
 #include "avatar.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
+#include "cata_arena.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "catalua.h"
@@ -59,6 +61,7 @@
 #include "map.h"
 #include "map_extras.h"
 #include "map_iterator.h"
+#include "mapbuffer.h"
 #include "mapgen.h"
 #include "mapgendata.h"
 #include "martialarts.h"
@@ -77,6 +80,7 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "pathfinding.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -86,6 +90,7 @@
 #include "rng.h"
 #include "sounds.h"
 #include "stomach.h"
+#include "submap.h"
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_input_popup.h"
@@ -184,6 +189,9 @@ enum debug_menu_index {
     DEBUG_DISPLAY_RADIATION,
     DEBUG_DISPLAY_TRANSPARENCY,
     DEBUG_DISPLAY_SUBMAP_GRID,
+    DEBUG_SHOW_MAPBUFFER_STATS,
+    DEBUG_SHOW_ITEM_ARENA_STATS,
+    DEBUG_SHOW_PATHFINDING_STATS,
     DEBUG_TEST_MAP_EXTRA_DISTRIBUTION,
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_VEHICLE_EXPORT_JSON,
@@ -234,6 +242,9 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_DISPLAY_TRANSPARENCY, true, 'p', _( "Toggle display transparency" ) ) },
             { uilist_entry( DEBUG_DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
             { uilist_entry( DEBUG_DISPLAY_SUBMAP_GRID, true, 'o', _( "Toggle display submap grid" ) ) },
+            { uilist_entry( DEBUG_SHOW_MAPBUFFER_STATS, true, 'k', _( "Show map buffer statistics" ) ) },
+            { uilist_entry( DEBUG_SHOW_ITEM_ARENA_STATS, true, 'A', _( "Show item allocation statistics" ) ) },
+            { uilist_entry( DEBUG_SHOW_PATHFINDING_STATS, true, 'P', _( "Show pathfinding statistics" ) ) },
             { uilist_entry( DEBUG_SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( DEBUG_SHOW_MUT_CHANCES, true, 'u', _( "Show mutation trait chances" ) ) },
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
@@ -1443,7 +1454,7 @@ void debug()
             for( int i = 0; i < OMAPX; i++ ) {
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int k = -OVERMAP_DEPTH; k <= OVERMAP_HEIGHT; k++ ) {
-                        cur_om.seen( { i, j, k } ) = true;
+                        cur_om.set_seen( { i, j, k }, true );
                     }
                 }
             }
@@ -1865,6 +1876,57 @@ void debug()
         case DEBUG_DISPLAY_SUBMAP_GRID:
             g->debug_submap_grid_overlay = !g->debug_submap_grid_overlay;
             break;
+        case DEBUG_SHOW_MAPBUFFER_STATS: {
+            const mapbuffer_stats stats = MAPBUFFER.get_stats();
+            const uint64_t lookups = stats.hits + stats.misses;
+            size_t item_bytes = 0;
+            for( const auto &buffered : MAPBUFFER ) {
+                item_bytes += buffered.second->item_storage_bytes();
+            }
+            popup_top( _( "Buffered submaps: %d (limit: %d)\n"
+                          "Lookups: %d, hits: %d (%.1f%%)\n"
+                          "Misses: %d, loaded from save: %d\n"
+                          "Evicted submaps: %d\n"
+                          "Item lists: %.0f bytes per submap (%d with one on every square)" ),
+                       MAPBUFFER.size(), mapbuffer_submap_limit,
+                       lookups, stats.hits, lookups == 0 ? 0.0 : 100.0 * stats.hits / lookups,
+                       stats.misses, stats.loads, stats.evictions,
+                       MAPBUFFER.size() == 0 ? 0.0 : static_cast<double>( item_bytes ) / MAPBUFFER.size(),
+                       submap::dense_item_storage_bytes() );
+            break;
+        }
+        case DEBUG_SHOW_ITEM_ARENA_STATS: {
+            const cata_arena_stats stats = cata_arena<item>::get_stats();
+            popup_top( _( "Items allocated: %d (peak: %d)\n"
+                          "Allocations: %d, releases: %d\n"
+                          "Waiting for deletion: %d\n"
+                          "Slabs: %d, heap fallbacks: %d" ),
+                       stats.live, stats.peak_live, stats.allocations, stats.releases,
+                       stats.pending, stats.slabs, stats.heap_fallbacks );
+            break;
+        }
+        case DEBUG_SHOW_PATHFINDING_STATS: {
+            const auto describe = []( const pathfinding_stats & stats ) {
+                const uint64_t d_maps = stats.d_maps_built + stats.d_maps_reused;
+                const double route_us = std::chrono::duration<double, std::micro>( stats.route_time ).count();
+                return string_format( _( "Routes: %d, average %.1f us\n"
+                                         "d_maps built: %d, reused: %d (%.1f%%)\n"
+                                         "d_maps rebuilt: %d, invalidated: %d\n"
+                                         "Tiles expanded: %d\n"
+                                         "Routes planned over submaps: %d, submaps built: %d" ),
+                                      stats.routes, stats.routes == 0 ? 0.0 : route_us / stats.routes,
+                                      stats.d_maps_built, stats.d_maps_reused,
+                                      d_maps == 0 ? 0.0 : 100.0 * stats.d_maps_reused / d_maps,
+                                      stats.d_maps_rebuilt, stats.d_maps_invalidated, stats.tiles_expanded,
+                                      stats.abstract_routes, stats.clusters_built );
+            };
+            if( query_yn( _( "%s\n\nLast turn:\n%s\n\nReset the counters?" ),
+                          describe( Pathfinding::get_stats() ),
+                          describe( Pathfinding::get_last_turn_stats() ) ) ) {
+                Pathfinding::reset_stats();
+            }
+            break;
+        }
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
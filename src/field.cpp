@@ -1,6 +1,8 @@
 #include "field.h"
 
 #include <algorithm>
+#include <iterator>
+#include <memory>
 #include <utility>
 
 #include "calendar.h"
@@ -141,10 +143,116 @@ time_duration field_entry::set_field_age( const time_duration &new_age )
 }
 
 field::field()
-    : _displayed_field_type( fd_null )
+    : _inline_entries{ value_type( fd_null, field_entry() ), value_type( fd_null, field_entry() ) },
+      _displayed_field_type( fd_null )
 {
 }
 
+field::field( const field &source ) : field()
+{
+    copy_entries( source );
+}
+
+field::field( field &&source ) noexcept : field()
+{
+    *this = std::move( source );
+}
+
+field &field::operator=( const field &source )
+{
+    if( this != &source ) {
+        copy_entries( source );
+    }
+    return *this;
+}
+
+field &field::operator=( field &&source ) noexcept
+{
+    if( this != &source ) {
+        for( int i = 0; i < inline_entries; i++ ) {
+            std::destroy_at( &_inline_entries[i] );
+            std::construct_at( &_inline_entries[i], source._inline_entries[i] );
+            std::destroy_at( &source._inline_entries[i] );
+            std::construct_at( &source._inline_entries[i], fd_null, field_entry() );
+        }
+        _overflow_entries = std::move( source._overflow_entries );
+        source._overflow_entries.clear();
+        _displayed_field_type = source._displayed_field_type;
+        source._displayed_field_type = fd_null;
+    }
+    return *this;
+}
+
+void field::copy_entries( const field &source )
+{
+    for( int i = 0; i < inline_entries; i++ ) {
+        std::destroy_at( &_inline_entries[i] );
+        std::construct_at( &_inline_entries[i], source._inline_entries[i] );
+    }
+    _overflow_entries = source._overflow_entries;
+    _displayed_field_type = source._displayed_field_type;
+}
+
+field::value_type *field::find_entry( const field_type_id &type ) const
+{
+    for( const value_type &entry : _inline_entries ) {
+        if( entry.first == type ) {
+            return const_cast<value_type *>( &entry );
+        }
+    }
+    for( const value_type &entry : _overflow_entries ) {
+        if( entry.first == type ) {
+            return const_cast<value_type *>( &entry );
+        }
+    }
+    return nullptr;
+}
+
+field::value_type *field::next_entry( const value_type *after ) const
+{
+    const value_type *next = nullptr;
+    const auto consider = [&]( const value_type & entry ) {
+        if( entry.first && ( after == nullptr || after->first < entry.first ) &&
+            ( next == nullptr || entry.first < next->first ) ) {
+            next = &entry;
+        }
+    };
+    for( const value_type &entry : _inline_entries ) {
+        consider( entry );
+    }
+    for( const value_type &entry : _overflow_entries ) {
+        consider( entry );
+    }
+    return const_cast<value_type *>( next );
+}
+
+void field::add_entry( const field_type_id &type, const field_entry &entry )
+{
+    for( value_type &slot : _inline_entries ) {
+        if( !slot.first ) {
+            // The type is const, so the unused slot is replaced instead of assigned
+            std::destroy_at( &slot );
+            std::construct_at( &slot, type, entry );
+            return;
+        }
+    }
+    _overflow_entries.emplace_front( type, entry );
+}
+
+void field::remove_entry( value_type *entry )
+{
+    for( value_type &slot : _inline_entries ) {
+        if( &slot == entry ) {
+            std::destroy_at( &slot );
+            std::construct_at( &slot, fd_null, field_entry() );
+            return;
+        }
+    }
+    _overflow_entries.remove_if( [entry]( const value_type & e ) {
+        return &e == entry;
+    } );
+}
+
 /*
 Function: find_field
 Returns a field entry corresponding to the field_type_id parameter passed in. If no fields are found then returns NULL.
@@ -152,26 +260,20 @@ Good for checking for existence of a field: if(myfield.find_field(fd_fire)) woul
 */
 field_entry *field::find_field( const field_type_id &field_type_to_find )
 {
-    if( !_displayed_field_type ) {
+    if( !_displayed_field_type || !field_type_to_find ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    value_type *const entry = find_entry( field_type_to_find );
+    return entry ? &entry->second : nullptr;
 }
 
 const field_entry *field::find_field_c( const field_type_id &field_type_to_find ) const
 {
-    if( !_displayed_field_type ) {
+    if( !_displayed_field_type || !field_type_to_find ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    const value_type *const entry = find_entry( field_type_to_find );
+    return entry ? &entry->second : nullptr;
 }
 
 const field_entry *field::find_field( const field_type_id &field_type_to_find ) const
@@ -195,8 +297,8 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         debugmsg( "Tried to add null field" );
         return false;
     }
-    auto it = _field_type_list.find( field_type_to_add );
-    if( it != _field_type_list.end() ) {
+    value_type *const it = find_entry( field_type_to_add );
+    if( it != nullptr ) {
         // Most fields stack intensities, but some add duration instead
         if( it->first->stacking_type == fields::stacking_type::intensity ) {
             it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
@@ -212,29 +314,30 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    add_entry( field_type_to_add, field_entry( field_type_to_add, new_intensity, new_age ) );
     return true;
 }
 
 bool field::remove_field( const field_type_id &field_to_remove )
 {
-    const auto it = _field_type_list.find( field_to_remove );
-    if( it == _field_type_list.end() ) {
+    if( !field_to_remove ) {
+        return false;
+    }
+    value_type *const entry = find_entry( field_to_remove );
+    if( entry == nullptr ) {
         return false;
     }
-    remove_field( it );
+    remove_field( iterator( this, entry ) );
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+void field::remove_field( const iterator it )
 {
-    _field_type_list.erase( it );
+    remove_entry( it.entry );
     _displayed_field_type = fd_null;
-    if( !_field_type_list.empty() ) {
-        for( auto &fld : _field_type_list ) {
-            if( !_displayed_field_type || fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
-                _displayed_field_type = fld.first;
-            }
+    for( auto &fld : *this ) {
+        if( !_displayed_field_type || fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
+            _displayed_field_type = fld.first;
         }
     }
 }
@@ -245,27 +348,33 @@ Returns the number of fields existing on the current tile.
 */
 unsigned int field::field_count() const
 {
-    return _field_type_list.size();
+    unsigned int count = std::distance( _overflow_entries.begin(), _overflow_entries.end() );
+    for( const value_type &entry : _inline_entries ) {
+        if( entry.first ) {
+            count++;
+        }
+    }
+    return count;
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::iterator field::begin()
 {
-    return _field_type_list.begin();
+    return iterator( this, next_entry( nullptr ) );
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::const_iterator field::begin() const
 {
-    return _field_type_list.begin();
+    return const_iterator( this, next_entry( nullptr ) );
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::iterator field::end()
 {
-    return _field_type_list.end();
+    return iterator( this, nullptr );
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::const_iterator field::end() const
 {
-    return _field_type_list.end();
+    return const_iterator( this, nullptr );
 }
 
 /*
@@ -285,7 +394,7 @@ description_affix field::displayed_description_affix() const
 int field::total_move_cost() const
 {
     int current_cost = 0;
-    for( auto &fld : _field_type_list ) {
+    for( const auto &fld : *this ) {
         current_cost += fld.second.move_cost();
     }
     return current_cost;
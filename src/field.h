@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <forward_list>
+#include <iterator>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -125,10 +129,70 @@ class field_entry
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref displayed_field_type to specific which field should be drawn on the map.
 */
+/**
+ * All field entries on a tile, ordered by their type.
+ *
+ * Tiles rarely hold more than a couple of fields, so the first entries are stored inline
+ * and only further ones are allocated. Like with std::map, adding or removing entries does
+ * not invalidate references and iterators to the other entries, so fields can be added to
+ * a tile while iterating over it.
+ */
 class field
 {
     public:
+        using value_type = std::pair<const field_type_id, field_entry>;
+
+        template<typename Value>
+        class iterator_base
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using difference_type = std::ptrdiff_t;
+                using value_type = field::value_type;
+                using pointer = Value *;
+                using reference = Value &;
+
+                iterator_base() = default;
+                iterator_base( const field *home, Value *entry ) : home( home ), entry( entry ) {}
+                template<typename Other>
+                iterator_base( const iterator_base<Other> &source ) : home( source.home ),
+                    entry( source.entry ) {}
+
+                reference operator*() const {
+                    return *entry;
+                }
+                pointer operator->() const {
+                    return entry;
+                }
+                iterator_base &operator++() {
+                    entry = home->next_entry( entry );
+                    return *this;
+                }
+                iterator_base operator++( int ) {
+                    iterator_base tmp = *this;
+                    ++( *this );
+                    return tmp;
+                }
+                friend bool operator==( const iterator_base &a, const iterator_base &b ) {
+                    return a.entry == b.entry;
+                }
+
+            private:
+                template<typename Other>
+                friend class iterator_base;
+                friend class field;
+
+                const field *home = nullptr;
+                Value *entry = nullptr;
+        };
+        using iterator = iterator_base<value_type>;
+        using const_iterator = iterator_base<const value_type>;
+
         field();
+        field( const field &source );
+        field( field &&source ) noexcept;
+        field &operator=( const field &source );
+        field &operator=( field &&source ) noexcept;
 
         /**
          * Returns a field entry corresponding to the field_type_id parameter passed in.
@@ -165,9 +229,9 @@ class field
         bool remove_field( const field_type_id &field_to_remove );
         /**
          * Make sure to decrement the field counter in the submap.
-         * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * Removes the field entry, the iterator must point into this field and must be valid.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        void remove_field( iterator );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -179,13 +243,13 @@ class field
 
         description_affix displayed_description_affix() const;
 
-        //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        //Returns the iterator to begin searching through the list.
+        iterator begin();
+        const_iterator begin() const;
 
-        //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        //Returns the iterator to end searching through the list.
+        iterator end();
+        const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -193,10 +257,21 @@ class field
         int total_move_cost() const;
 
     private:
-        // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        static constexpr int inline_entries = 2;
+
+        // Entries of the first fields on the tile, unused ones have a null type.
+        value_type _inline_entries[inline_entries];
+        // Entries that didn't fit inline. Nodes of a list don't move, unlike vector elements.
+        std::forward_list<value_type> _overflow_entries;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
+
+        value_type *find_entry( const field_type_id &type ) const;
+        /** The entry with the lowest type after @p after, or the first one if it's null. */
+        value_type *next_entry( const value_type *after ) const;
+        void add_entry( const field_type_id &type, const field_entry &entry );
+        void remove_entry( value_type *entry );
+        void copy_entries( const field &source );
 };
 
 
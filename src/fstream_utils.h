@@ -102,6 +102,7 @@ struct cata_ifstream {
 using file_read_fn = const std::function<void( std::istream & )> &;
 using file_read_json_fn = const std::function<void( JsonIn & )> &;
 using file_write_fn = const std::function<void( std::ostream & )> &;
+using file_write_json_fn = const std::function<void( JsonOut & )> &;
 
 /**
  * Open a file for writing, calls the writer on that stream.
@@ -45,6 +45,7 @@
 #include "avatar_functions.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "catacharset.h"
@@ -481,6 +482,7 @@ void game::setup( bool load_world_modfiles )
     }
 
     m = map();
+    map_quads_ahead.clear();
 
     next_npc_id = character_id( 1 );
     next_mission_id = 1;
@@ -544,6 +546,8 @@ void game::load_map( const tripoint &pos_sm, const bool pump_events )
 void game::load_map( const tripoint_abs_sm &pos_sm,
                      const bool pump_events )
 {
+    // Quads queued around the old position aren't ahead of the player anymore
+    map_quads_ahead.clear();
     m.load( pos_sm, true, pump_events );
     grid_tracker_ptr->load( m );
 }
@@ -1222,6 +1226,7 @@ bool game::cleanup_at_end()
 
     MAPBUFFER.clear();
     overmap_buffer.clear();
+    map_quads_ahead.clear();
 
     avatar &player_character = get_avatar();
     player_character = avatar();
@@ -1463,6 +1468,8 @@ bool game::do_turn()
                 if( handle_action() ) {
                     ++moves_since_last_save;
                 }
+                // Whatever the player did may have changed what they and others can see
+                Creature::invalidate_sight_cache();
 
                 if( is_game_over() ) {
                     return cleanup_at_end();
@@ -1536,6 +1543,10 @@ bool game::do_turn()
     explosion_handler::get_explosion_queue().execute();
     cleanup_dead();
 
+    if( pregenerate_map ) {
+        generate_map_ahead();
+    }
+
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
         ui_manager::redraw();
         refresh_display();
@@ -4073,6 +4084,8 @@ void game::mon_info_update( )
 
 void game::cleanup_dead()
 {
+    // Remembered sight between creatures refers to them by address
+    Creature::invalidate_sight_cache();
     // Dead monsters need to stay in the tracker until everything else that needs to die does so
     // This is because dying monsters can still interact with other dying monsters (@ref Creature::killer)
     bool monster_is_dead = critter_tracker->kill_marked_for_death();
@@ -4204,6 +4217,8 @@ void game::monmove()
              ) {
             int moves = guy.moves;
             guy.move();
+            // Whatever the NPC did may have changed what they and others can see
+            Creature::invalidate_sight_cache();
             if( moves == guy.moves ) {
                 // Count every time we exit npc::move() without spending any moves.
                 turns++;
@@ -10823,6 +10838,14 @@ point game::update_map( int &x, int &y )
 
     grid_tracker_ptr->load( m );
 
+    if( mapbuffer_submap_limit > 0 ) {
+        MAPBUFFER.evict_cold_submaps( m.get_abs_sub(), mapbuffer_submap_limit );
+    }
+
+    if( prefetch_submaps || pregenerate_map ) {
+        prefetch_map_ahead( shift );
+    }
+
     // Shift monsters
     shift_monsters( tripoint( shift, 0 ) );
     const point shift_ms = sm_to_ms_copy( shift );
@@ -10874,6 +10897,88 @@ point game::update_map( int &x, int &y )
     return shift;
 }
 
+void game::prefetch_map_ahead( const point &shift )
+{
+    const world *active_world = get_active_world();
+    if( active_world == nullptr ) {
+        return;
+    }
+
+    // Number of submaps past the edge of the map to read, more when driving fast.
+    // A quad is two submaps, or 24 tiles, and a tile is about a meter.
+    int lookahead = 2;
+    if( u.in_vehicle && u.controlling_vehicle ) {
+        if( const vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) ) ) {
+            const int mps = static_cast<int>( std::abs( vmiph_to_mps( veh->velocity ) ) );
+            lookahead = clamp( 2 + mps / 6, 2, 8 );
+        }
+    }
+
+    const tripoint abs_sub = m.get_abs_sub();
+    const int map_size = m.getmapsize();
+    const point dir( shift.x > 0 ? 1 : shift.x < 0 ? -1 : 0, shift.y > 0 ? 1 : shift.y < 0 ? -1 : 0 );
+    // Range of submaps covered by the map, grown by the lookahead in the travel direction
+    const point min_sm( abs_sub.x - ( dir.x < 0 ? lookahead : 0 ),
+                        abs_sub.y - ( dir.y < 0 ? lookahead : 0 ) );
+    const point max_sm( abs_sub.x + map_size - 1 + ( dir.x > 0 ? lookahead : 0 ),
+                        abs_sub.y + map_size - 1 + ( dir.y > 0 ? lookahead : 0 ) );
+
+    // Only the player's level, the levels above and below are mostly uniform air and rock
+    std::set<tripoint> quad_set;
+    for( int x = min_sm.x; x <= max_sm.x; x++ ) {
+        for( int y = min_sm.y; y <= max_sm.y; y++ ) {
+            const bool ahead = x < abs_sub.x || x >= abs_sub.x + map_size ||
+                               y < abs_sub.y || y >= abs_sub.y + map_size;
+            if( !ahead ) {
+                continue;
+            }
+            const tripoint om_addr = sm_to_omt_copy( tripoint( x, y, abs_sub.z ) );
+            // Submaps are loaded and stored in whole quads
+            if( !MAPBUFFER.is_submap_loaded( omt_to_sm_copy( om_addr ) ) ) {
+                quad_set.insert( om_addr );
+            }
+        }
+    }
+    // Nearest to the player, who is kept in the middle of the map, first
+    const tripoint center = sm_to_omt_copy( abs_sub + point( map_size / 2, map_size / 2 ) );
+    std::vector<tripoint> quads( quad_set.begin(), quad_set.end() );
+    std::stable_sort( quads.begin(), quads.end(),
+    [&center]( const tripoint & a, const tripoint & b ) {
+        return rl_dist( a, center ) < rl_dist( b, center );
+    } );
+    if( prefetch_submaps ) {
+        // More than the prefetcher keeps would push out the nearest quads
+        const size_t count = std::min( quads.size(), world::max_prefetched_map_quads );
+        active_world->prefetch_map_quads( std::vector<tripoint>( quads.begin(),
+                                          quads.begin() + count ) );
+    }
+    if( pregenerate_map ) {
+        map_quads_ahead.assign( quads.rbegin(), quads.rend() );
+    }
+}
+
+void game::generate_map_ahead()
+{
+    ZoneScoped;
+    // Quads read from the save per turn, a mapgen run counts as several reads
+    constexpr int budget_per_turn = 4;
+    constexpr int mapgen_cost = 4;
+    int budget = budget_per_turn;
+    while( budget > 0 && !map_quads_ahead.empty() ) {
+        const tripoint om_addr = map_quads_ahead.back();
+        map_quads_ahead.pop_back();
+        const tripoint abs_sub = omt_to_sm_copy( om_addr );
+        if( MAPBUFFER.is_submap_loaded( abs_sub ) ) {
+            continue;
+        }
+        // Generating a whole overmap is left to the map when it actually gets there
+        if( !overmap_buffer.has( project_to<coords::om>( tripoint_abs_omt( om_addr ) ).xy() ) ) {
+            continue;
+        }
+        budget -= map::generate_missing_omt( abs_sub ) ? mapgen_cost : 1;
+    }
+}
+
 void game::update_overmap_seen()
 {
     const tripoint_abs_omt ompos = u.global_omt_location();
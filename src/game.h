@@ -517,6 +517,10 @@ class game
         // Helper to make calling with a player pointer less verbose.
         point update_map( player &p );
         point update_map( int &x, int &y );
+        // Start reading the map quads the next shifts in the direction of @p shift will need
+        void prefetch_map_ahead( const point &shift );
+        // Load or generate the nearest map quads queued by prefetch_map_ahead, a few per turn
+        void generate_map_ahead();
         void update_overmap_seen(); // Update which overmap tiles we can see
 
         void process_artifact( item &it, player &p );
@@ -1020,6 +1024,8 @@ class game
         int moves_since_last_save = 0;
         time_t last_save_timestamp;
         mutable std::array<float, OVERMAP_LAYERS> latest_lightlevels;
+        /** Map quads ahead of the player that may still need mapgen, nearest last */
+        std::vector<tripoint> map_quads_ahead;
         // remoteveh() cache
         time_point remoteveh_cache_time;
         vehicle *remoteveh_cache;
@@ -387,6 +387,8 @@ auto game_info::save_file_version() -> std::string
             return "V1";
         case save_format::V2_COMPRESSED_SQLITE3:
             return "V2 (compressed with sqlite 3)";
+        case save_format::V2_LZ4_SQLITE3:
+            return "V2 (compressed with lz4 with sqlite 3)";
     }
     return "No save format";
 }
@@ -1,14 +1,19 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <fstream>
-#include <iterator>
+#include <functional>
+#include <future>
 #include <memory>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "achievement.h"
@@ -42,11 +47,13 @@
 #include "fault.h"
 #include "field_type.h"
 #include "filesystem.h"
-#include "fstream_utils.h"
 #include "flag.h"
 #include "flag_trait.h"
+#include "fstream_utils.h"
 #include "gates.h"
+#include "get_version.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "item_action.h"
 #include "item_category.h"
 #include "item_factory.h"
@@ -74,12 +81,14 @@
 #include "npc.h"
 #include "npc_class.h"
 #include "omdata.h"
+#include "options.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -96,6 +105,7 @@
 #include "start_location.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -136,7 +146,10 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     if( it == type_function_map.end() ) {
         jo.throw_error( "unrecognized JSON object", "type" );
     }
+    const auto start = std::chrono::steady_clock::now();
     it->second( jo, src, base_path, full_path );
+    type_load_times[type] += std::chrono::duration_cast<std::chrono::microseconds>
+                             ( std::chrono::steady_clock::now() - start );
 }
 
 shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::string &path )
@@ -466,6 +479,23 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+struct prefetched_json {
+    std::string data;
+    size_t content_hash = 0;
+};
+} // namespace
+
+// Runs on a worker thread, must not touch any game state
+static prefetched_json prefetch_json_file( const std::string &file )
+{
+    prefetched_json result;
+    result.data = read_entire_file( file );
+    result.content_hash = std::hash<std::string_view>()( result.data );
+    return result;
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
@@ -486,25 +516,84 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    // Files are read on worker threads a few files ahead, and parsed and
+    // dispatched here in the original order
+    cata::thread_pool &pool = cata::get_thread_pool();
+    const size_t read_ahead = get_option<bool>( "PREFETCH_DATA_FILES" ) ?
+                              std::max<size_t>( 4, pool.num_workers() * 2 ) : 0;
+    std::deque<std::future<prefetched_json>> pending;
+    size_t next_file = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::microseconds read_wait_time( 0 );
+    std::vector<std::pair<std::chrono::microseconds, std::string>> file_times;
+    type_load_times.clear();
+    cata::hash_combine( data_fingerprint, src );
+    for( const std::string &file : files ) {
+        while( next_file < files.size() && pending.size() < read_ahead ) {
+            pending.push_back( pool.submit( [path = files[next_file]]() {
+                return prefetch_json_file( path );
+            }, cata::task_priority::high, "prefetch_json_file" ) );
+            next_file++;
+        }
+        const auto wait_start = std::chrono::steady_clock::now();
+        prefetched_json prefetched;
+        if( pending.empty() ) {
+            prefetched = prefetch_json_file( file );
+        } else {
+            pool.help_until_ready( pending.front() );
+            prefetched = pending.front().get();
+            pending.pop_front();
+        }
+        const auto file_start = std::chrono::steady_clock::now();
+        read_wait_time += std::chrono::duration_cast<std::chrono::microseconds>( file_start - wait_start );
+
+        cata::hash_combine( data_fingerprint, file );
+        cata::hash_combine( data_fingerprint, prefetched.content_hash );
         try {
             // parse it
-            JsonIn jsin( iss, file );
+            JsonIn jsin( prefetched.data, file );
             load_all_from_json( jsin, src, ui, path, file );
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
+        file_times.emplace_back( std::chrono::duration_cast<std::chrono::microseconds>
+                                 ( std::chrono::steady_clock::now() - file_start ), file );
+    }
+    // Lua scripts of the mod can change the loaded data too
+    for( const std::string &script : get_files_from_path( ".lua", path, true, true ) ) {
+        cata::hash_combine( data_fingerprint, script );
+        cata::hash_combine( data_fingerprint, read_entire_file( script ) );
+    }
+    log_load_times( path, std::chrono::duration_cast<std::chrono::microseconds>
+                    ( std::chrono::steady_clock::now() - start ), read_wait_time, file_times );
+}
+
+void DynamicDataLoader::log_load_times( const std::string &path,
+                                        std::chrono::microseconds total, std::chrono::microseconds read_wait,
+                                        std::vector<std::pair<std::chrono::microseconds, std::string>> &file_times ) const
+{
+    constexpr size_t num_reported = 5;
+    const auto ms = []( std::chrono::microseconds t ) {
+        return static_cast<long long>( t.count() / 1000 );
+    };
+    DebugLog( DL::Info, DC::Main ) << "Loaded " << file_times.size() << " json files from " << path
+                                   << " in " << ms( total ) << " ms, " << ms( read_wait )
+                                   << " ms waiting for file reads";
+
+    std::sort( file_times.begin(), file_times.end(), std::greater<>() );
+    for( size_t i = 0; i < std::min( num_reported, file_times.size() ); i++ ) {
+        DebugLog( DL::Info, DC::Main ) << "  " << file_times[i].second << ": "
+                                       << ms( file_times[i].first ) << " ms";
+    }
+
+    std::vector<std::pair<std::chrono::microseconds, type_string>> type_times;
+    for( const auto &entry : type_load_times ) {
+        type_times.emplace_back( entry.second, entry.first );
+    }
+    std::sort( type_times.begin(), type_times.end(), std::greater<>() );
+    for( size_t i = 0; i < std::min( num_reported, type_times.size() ); i++ ) {
+        DebugLog( DL::Info, DC::Main ) << "  type " << type_times[i].second << ": "
+                                       << ms( type_times[i].first ) << " ms";
     }
 }
 
@@ -540,6 +629,7 @@ void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    data_fingerprint = 0;
 
     //Moved to the top as a temp hack until vehicles are made into game objects
     vehicle_prototype::reset();
@@ -825,15 +915,52 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
     finalized = true;
 }
 
+// Identifies the loaded data together with the build that checked it
+static std::string data_verification_key( size_t fingerprint )
+{
+    size_t key = fingerprint;
+    cata::hash_combine( key, std::string( getVersionString() ) );
+    cata::hash_combine( key, cata::has_lua() );
+    return std::to_string( key );
+}
+
+bool DynamicDataLoader::is_data_verified() const
+{
+    if( !get_option<bool>( "VERIFIED_DATA_CACHE" ) || data_fingerprint == 0 ) {
+        return false;
+    }
+    std::string verified_key;
+    read_from_file_json( PATH_INFO::data_verification(), [&verified_key]( JsonIn & jsin ) {
+        JsonObject jo = jsin.get_object();
+        verified_key = jo.get_string( "key" );
+    }, true );
+    return verified_key == data_verification_key( data_fingerprint );
+}
+
+void DynamicDataLoader::remember_data_verified() const
+{
+    if( !get_option<bool>( "VERIFIED_DATA_CACHE" ) || data_fingerprint == 0 ) {
+        return;
+    }
+    write_to_file( PATH_INFO::data_verification(), [&]( std::ostream & file ) {
+        JsonOut jsout( file, true );
+        jsout.start_object();
+        jsout.member( "key", data_verification_key( data_fingerprint ) );
+        jsout.end_object();
+    }, _( "data verification cache" ) );
+}
+
 /**
  * Load & finalize specified content packs.
  * @param ui structure for load progress display
  * @param msg string to display whilst loading prompt
  * @param packs content packs to load in correct dependent order
+ * @param allow_verified_cache skip consistency checks of data that passed them before
  */
 static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
-                                     const std::vector<mod_id> &packs )
+                                     const std::vector<mod_id> &packs, bool allow_verified_cache = true )
 {
+    const bool errors_before = debug_has_error_been_observed();
     ui.new_context( msg );
     std::vector<mod_id> missing;
     std::vector<mod_id> available;
@@ -899,7 +1026,15 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
         }
     }
 
-    loader.check_consistency( ui );
+    if( allow_verified_cache && loader.is_data_verified() ) {
+        DebugLog( DL::Info, DC::Main ) << "Skipping consistency checks, the same data passed them before";
+        loader.mark_finalized();
+    } else {
+        loader.check_consistency( ui );
+        if( allow_verified_cache && !errors_before && !debug_has_error_been_observed() ) {
+            loader.remember_data_verified();
+        }
+    }
 
     if( cata::has_lua() ) {
         init::load_main_lua_scripts( *loader.lua, packs );
@@ -1037,7 +1172,7 @@ bool init::check_mods_for_errors( loading_ui &ui, const std::vector<mod_id> &opt
         mods_list.push_back( id );
 
         try {
-            load_and_finalize_packs( ui, _( "Checking mods" ), mods_list );
+            load_and_finalize_packs( ui, _( "Checking mods" ), mods_list, false );
         } catch( const std::exception &err ) {
             std::cerr << "Error loading data: " << err.what() << '\n';
         }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <list>
 #include <map>
@@ -80,6 +81,10 @@ class DynamicDataLoader
          * functor that loads that kind of object from json.
          */
         t_type_function_map type_function_map;
+        /** Hash of the mods and file contents loaded since the last @ref unload_data. */
+        size_t data_fingerprint = 0;
+        /** Time spent in the loader of each type, reset for every loaded path. */
+        std::map<type_string, std::chrono::microseconds> type_load_times;
         void add( const std::string &type, const std::function<void( const JsonObject & )> &f );
         void add( const std::string &type,
                   const std::function<void( const JsonObject &, const std::string & )> &f );
@@ -107,6 +112,10 @@ class DynamicDataLoader
                           const std::string &base_path = std::string(),
                           const std::string &full_path = std::string() );
 
+        /** Logs where the time to load @p path went, @p file_times gets sorted. */
+        void log_load_times( const std::string &path, std::chrono::microseconds total,
+                             std::chrono::microseconds read_wait,
+                             std::vector<std::pair<std::chrono::microseconds, std::string>> &file_times ) const;
         DynamicDataLoader();
         ~DynamicDataLoader();
         /**
@@ -168,6 +177,28 @@ class DynamicDataLoader
             return finalized;
         }
 
+        /**
+         * Marks the loaded data as finalized without running @ref check_consistency,
+         * for data that already passed it as reported by @ref is_data_verified.
+         */
+        void mark_finalized() {
+            finalized = true;
+        }
+
+        /**
+         * Returns whether the currently loaded data already passed @ref check_consistency
+         * without errors in an earlier run, as recorded by @ref remember_data_verified.
+         * Always false unless enabled with the VERIFIED_DATA_CACHE option.
+         * Only the checks can be skipped, there is no cache of the finalized data itself,
+         * so it is still parsed and finalized from JSON on every load.
+         */
+        bool is_data_verified() const;
+        /**
+         * Records that the currently loaded data passed @ref check_consistency without errors,
+         * so later runs loading the same files can skip it.
+         */
+        void remember_data_verified() const;
+
         /**
          * Get a possibly cached stream for deferred data loading. If the cached
          * stream is still in use by outside code, this returns a new stream to
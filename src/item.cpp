@@ -9547,12 +9547,11 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = weather.get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
         // It's a modifier, so we need to subtract 0_f
         units::temperature local_mod = units::from_fahrenheit( g->new_game
                                        ? 0
                                        : get_map().get_temperature( pos ) ) - 0_f;
+        const tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
 
         // Process the past of this item since the last time it was processed
         while( now - time > 1_hours ) {
@@ -9563,9 +9562,8 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
             //Use weather if above ground, use map temp if below
             units::temperature env_temperature_raw;
             if( pos.z >= 0 ) {
-                tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
-                units::temperature weather_temperature = wgen.get_weather_temperature( location, time,
-                        calendar::config, seed );
+                // Shared with the other items here, they have mostly been checked at the same times
+                units::temperature weather_temperature = weather.get_weather_temperature( location, time );
                 env_temperature_raw = weather_temperature + local_mod;
             } else {
                 env_temperature_raw = temperatures::annual_average + local_mod;
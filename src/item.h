@@ -287,6 +287,13 @@ class item : public location_visitable<item>, public game_object<item>
         ~item();
         void on_destroy();
 
+        static void *operator new( size_t size ) {
+            return cata_arena<item>::allocate( size );
+        }
+        static void operator delete( void *ptr, size_t size ) {
+            cata_arena<item>::deallocate( ptr, size );
+        }
+
         inline static detached_ptr<item> spawn( JsonIn &jsin ) {
             detached_ptr<item> p = spawn();
             p->deserialize( jsin );
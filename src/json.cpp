@@ -1,6 +1,7 @@
 #include "json.h"
 
 #include <algorithm>
+#include <bit>
 #include <bitset>
 #include <cmath> // pow
 #include <cstdint>
@@ -23,6 +24,11 @@
 #include "string_formatter.h"
 #include "string_utils.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define CATA_JSON_SSE2
+#include <emmintrin.h>
+#endif
+
 // JSON parsing and serialization tools for Cataclysm-DDA.
 // For documentation, see the included header, json.h.
 
@@ -809,37 +815,216 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+bool json_input::get( char *s, int count )
+{
+    if( stream ) {
+        return static_cast<bool>( stream->get( s, count ) );
+    }
+    int read = 0;
+    if( good() ) {
+        while( read < count - 1 && pos != end && *pos != '\n' ) {
+            s[read++] = *pos++;
+        }
+        if( read < count - 1 && pos == end ) {
+            eof_bit = true;
+        }
+    }
+    if( count > 0 ) {
+        s[read] = '\0';
+    }
+    if( read == 0 ) {
+        fail_bit = true;
+    }
+    return !fail_bit;
+}
+
+void json_input::ignore()
+{
+    if( stream ) {
+        stream->ignore();
+    } else if( !good() ) {
+        fail_bit = true;
+    } else if( pos == end ) {
+        eof_bit = true;
+    } else {
+        ++pos;
+    }
+}
+
+void json_input::unget()
+{
+    if( stream ) {
+        stream->unget();
+        return;
+    }
+    eof_bit = false;
+    if( fail_bit ) {
+        return;
+    }
+    if( pos == begin ) {
+        fail_bit = true;
+    } else {
+        --pos;
+    }
+}
+
+void json_input::read( char *s, size_t count )
+{
+    if( stream ) {
+        stream->read( s, count );
+        return;
+    }
+    if( !good() ) {
+        fail_bit = true;
+        return;
+    }
+    const size_t available = std::min( count, static_cast<size_t>( end - pos ) );
+    std::copy( pos, pos + available, s );
+    pos += available;
+    if( available < count ) {
+        eof_bit = true;
+        fail_bit = true;
+    }
+}
+
+int json_input::tellg()
+{
+    if( stream ) {
+        return stream->tellg();
+    }
+    return fail_bit ? -1 : static_cast<int>( pos - begin );
+}
+
+void json_input::seekg( int offset, std::ios_base::seekdir dir )
+{
+    if( stream ) {
+        stream->seekg( offset, dir );
+        return;
+    }
+    eof_bit = false;
+    if( fail_bit ) {
+        return;
+    }
+    const char *base = dir == std::ios_base::beg ? begin : dir == std::ios_base::cur ? pos : end;
+    if( offset < begin - base || offset > end - base ) {
+        fail_bit = true;
+    } else {
+        pos = base + offset;
+    }
+}
+
+void json_input::skip_whitespace()
+{
+    if( !good() ) {
+        fail_bit = true;
+        return;
+    }
+    const char *p = pos;
+    // Usually there is no whitespace, or just a space after a separator
+    if( p != end && is_whitespace( *p ) ) {
+        ++p;
+#if defined(CATA_JSON_SSE2)
+        const __m128i space = _mm_set1_epi8( ' ' );
+        const __m128i newline = _mm_set1_epi8( '\n' );
+        const __m128i tab = _mm_set1_epi8( '\t' );
+        const __m128i carriage_return = _mm_set1_epi8( '\r' );
+        while( end - p >= 16 ) {
+            const __m128i chars = _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+            const __m128i ws = _mm_or_si128(
+                                   _mm_or_si128( _mm_cmpeq_epi8( chars, space ), _mm_cmpeq_epi8( chars, newline ) ),
+                                   _mm_or_si128( _mm_cmpeq_epi8( chars, tab ), _mm_cmpeq_epi8( chars, carriage_return ) ) );
+            const unsigned int other = ~static_cast<unsigned int>( _mm_movemask_epi8( ws ) ) & 0xFFFF;
+            if( other != 0 ) {
+                pos = p + std::countr_zero( other );
+                return;
+            }
+            p += 16;
+        }
+#endif
+        while( p != end && is_whitespace( *p ) ) {
+            ++p;
+        }
+    }
+    pos = p;
+    if( pos == end ) {
+        eof_bit = true;
+    }
+}
+
+static bool is_plain_string_char( char ch )
+{
+    const unsigned char uc = static_cast<unsigned char>( ch );
+    return uc >= 0x20 && uc < 0x80 && ch != '"' && ch != '\\';
+}
+
+std::string_view json_input::take_plain_string_chars()
+{
+    if( !good() ) {
+        return std::string_view();
+    }
+    const char *p = pos;
+#if defined(CATA_JSON_SSE2)
+    const __m128i quote = _mm_set1_epi8( '"' );
+    const __m128i backslash = _mm_set1_epi8( '\\' );
+    const __m128i first_printable = _mm_set1_epi8( 0x20 );
+    while( end - p >= 16 ) {
+        const __m128i chars = _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+        // Signed comparison, so bytes of multi-byte UTF-8 sequences count as below 0x20
+        const __m128i special = _mm_or_si128( _mm_cmplt_epi8( chars, first_printable ),
+                                              _mm_or_si128( _mm_cmpeq_epi8( chars, quote ), _mm_cmpeq_epi8( chars, backslash ) ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( special ) );
+        if( mask != 0 ) {
+            p += std::countr_zero( mask );
+            const std::string_view taken( pos, p - pos );
+            pos = p;
+            return taken;
+        }
+        p += 16;
+    }
+#endif
+    while( p != end && is_plain_string_char( *p ) ) {
+        ++p;
+    }
+    const std::string_view taken( pos, p - pos );
+    pos = p;
+    return taken;
+}
+
 int JsonIn::tell()
 {
-    return stream->tellg();
+    return input.tellg();
 }
 char JsonIn::peek()
 {
-    return static_cast<char>( stream->peek() );
+    return static_cast<char>( input.peek() );
 }
 bool JsonIn::good()
 {
-    return stream->good();
+    return input.good();
 }
 
 void JsonIn::seek( int pos )
 {
-    stream->clear();
-    stream->seekg( pos );
+    input.clear();
+    input.seekg( pos );
     ate_separator = false;
 }
 
 void JsonIn::eat_whitespace()
 {
+    if( input.is_buffer() ) {
+        input.skip_whitespace();
+        return;
+    }
     while( is_whitespace( peek() ) ) {
-        stream->get();
+        input.get();
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
     while( tell() > 0 ) {
-        stream->seekg( -1, std::istream::cur );
+        input.seekg( -1, std::istream::cur );
         if( !is_whitespace( peek() ) ) {
             break;
         }
@@ -867,7 +1052,7 @@ void JsonIn::skip_separator()
         if( ate_separator ) {
             error( "duplicate comma" );
         }
-        stream->get();
+        input.get();
         ate_separator = true;
     } else if( ch == ']' || ch == '}' || ch == ':' ) {
         // okay
@@ -896,7 +1081,7 @@ void JsonIn::skip_pair_separator()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    input.get( ch );
     if( ch != ':' ) {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
@@ -911,16 +1096,19 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    input.get( ch );
     if( ch != '"' ) {
         std::stringstream err;
         err << "expecting string but found '" << ch << "'";
         error( err.str(), -1 );
     }
-    while( stream->good() ) {
-        stream->get( ch );
+    while( input.good() ) {
+        if( input.is_buffer() ) {
+            input.take_plain_string_chars();
+        }
+        input.get( ch );
         if( ch == '\\' ) {
-            stream->get( ch );
+            input.get( ch );
             continue;
         } else if( ch == '"' ) {
             break;
@@ -985,7 +1173,7 @@ void JsonIn::skip_true()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    input.get( text, 5 );
     if( strcmp( text, "true" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "true", but found ")" << text << "\"";
@@ -998,7 +1186,7 @@ void JsonIn::skip_false()
 {
     char text[6];
     eat_whitespace();
-    stream->get( text, 6 );
+    input.get( text, 6 );
     if( strcmp( text, "false" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "false", but found ")" << text << "\"";
@@ -1011,7 +1199,7 @@ void JsonIn::skip_null()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    input.get( text, 5 );
     if( strcmp( text, "null" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "null", but found ")" << text << "\"";
@@ -1025,11 +1213,11 @@ void JsonIn::skip_number()
     char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while( stream->good() ) {
-        stream->get( ch );
+    while( input.good() ) {
+        input.get( ch );
         if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
             ch != 'e' && ch != 'E' && ch != '.' ) {
-            stream->unget();
+            input.unget();
             break;
         }
     }
@@ -1043,7 +1231,7 @@ std::string JsonIn::get_member_name()
     return s;
 }
 
-static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::string &err )
+static bool get_escaped_or_unicode( json_input &stream, std::string &s, std::string &err )
 {
     if( !stream.good() ) {
         err = "stream not good";
@@ -1186,8 +1374,8 @@ std::string JsonIn::get_string()
     bool success = false;
     do {
         // the first character had better be a '"'
-        stream->get( ch );
-        if( !stream->good() ) {
+        input.get( ch );
+        if( !input.good() ) {
             err = "read operation failed";
             break;
         }
@@ -1195,30 +1383,33 @@ std::string JsonIn::get_string()
             err = "expected string but got '" + std::string( 1, ch ) + "'";
             break;
         }
-        // add chars to the string, one at a time
+        // add chars to the string, one at a time, or whole runs of plain ones from buffers
         do {
-            ch = stream->peek();
-            if( !stream->good() ) {
+            if( input.is_buffer() ) {
+                s += input.take_plain_string_chars();
+            }
+            ch = input.peek();
+            if( !input.good() ) {
                 err = "read operation failed";
                 break;
             }
             if( ch == '"' ) {
-                stream->ignore();
+                input.ignore();
                 success = true;
                 break;
             }
-            if( !get_escaped_or_unicode( *stream, s, err ) ) {
+            if( !get_escaped_or_unicode( input, s, err ) ) {
                 break;
             }
-        } while( stream->good() );
+        } while( input.good() );
     } while( false );
     if( success ) {
         end_value();
         return s;
     }
-    if( stream->eof() ) {
+    if( input.eof() ) {
         error( "couldn't find end of string, reached EOF." );
-    } else if( stream->fail() ) {
+    } else if( input.fail() ) {
         error( "stream failure while reading string." );
     } else {
         error( err, -1 );
@@ -1358,11 +1549,11 @@ number_sci_notation JsonIn::get_any_number()
     number_sci_notation ret;
     int mod_e = 0;
     eat_whitespace();
-    if( !stream->get( ch ) ) {
+    if( !input.get( ch ) ) {
         error( "unexpected end of input", 0 );
     }
     if( ( ret.negative = ch == '-' ) ) {
-        if( !stream->get( ch ) ) {
+        if( !input.get( ch ) ) {
             error( "unexpected end of input", 0 );
         }
     } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
@@ -1373,7 +1564,7 @@ number_sci_notation JsonIn::get_any_number()
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
+        input.get( ch );
         if( ch >= '0' && ch <= '9' ) {
             error( "leading zeros not allowed", -1 );
         }
@@ -1381,31 +1572,31 @@ number_sci_notation JsonIn::get_any_number()
     while( ch >= '0' && ch <= '9' ) {
         ret.number *= 10;
         ret.number += ( ch - '0' );
-        if( !stream->get( ch ) ) {
+        if( !input.get( ch ) ) {
             break;
         }
     }
     if( ch == '.' ) {
-        while( stream->get( ch ) && ch >= '0' && ch <= '9' ) {
+        while( input.get( ch ) && ch >= '0' && ch <= '9' ) {
             ret.number *= 10;
             ret.number += ( ch - '0' );
             mod_e -= 1;
         }
     }
-    if( stream && ( ch == 'e' || ch == 'E' ) ) {
-        if( !stream->get( ch ) ) {
+    if( ch == 'e' || ch == 'E' ) {
+        if( !input.get( ch ) ) {
             error( "unexpected end of input", 0 );
         }
         bool neg;
         if( ( neg = ch == '-' ) || ch == '+' ) {
-            if( !stream->get( ch ) ) {
+            if( !input.get( ch ) ) {
                 error( "unexpected end of input", 0 );
             }
         }
         while( ch >= '0' && ch <= '9' ) {
             ret.exp *= 10;
             ret.exp += ( ch - '0' );
-            if( !stream->get( ch ) ) {
+            if( !input.get( ch ) ) {
                 break;
             }
         }
@@ -1414,9 +1605,7 @@ number_sci_notation JsonIn::get_any_number()
         }
     }
     // unget the final non-number character (probably a separator)
-    if( stream ) {
-        stream->unget();
-    }
+    input.unget();
     end_value();
     ret.exp += mod_e;
     return ret;
@@ -1428,9 +1617,9 @@ bool JsonIn::get_bool()
     char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get( ch );
+    input.get( ch );
     if( ch == 't' ) {
-        stream->get( text, 4 );
+        input.get( text, 4 );
         if( strcmp( text, "rue" ) == 0 ) {
             end_value();
             return true;
@@ -1440,7 +1629,7 @@ bool JsonIn::get_bool()
             error( err.str(), -4 );
         }
     } else if( ch == 'f' ) {
-        stream->get( text, 5 );
+        input.get( text, 5 );
         if( strcmp( text, "alse" ) == 0 ) {
             end_value();
             return false;
@@ -1468,7 +1657,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if( peek() == '[' ) {
-        stream->get();
+        input.get();
         ate_separator = false;
         return;
     } else {
@@ -1488,7 +1677,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error( "comma not allowed at end of array" );
         }
-        stream->get();
+        input.get();
         end_value();
         return true;
     } else {
@@ -1501,7 +1690,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if( peek() == '{' ) {
-        stream->get();
+        input.get();
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1521,7 +1710,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error( "comma not allowed at end of object" );
         }
-        stream->get();
+        input.get();
         end_value();
         return true;
     } else {
@@ -1582,7 +1771,7 @@ bool JsonIn::read_null( bool throw_on_error )
         return error_or_false( throw_on_error, "Expected null" );
     }
     char text[5];
-    if( !stream->get( text, 5 ) ) {
+    if( !input.get( text, 5 ) ) {
         error( "Unexpected end of stream reading null", 0 );
     }
     if( 0 != strcmp( text, "null" ) ) {
@@ -1838,14 +2027,14 @@ std::string JsonIn::line_number( int offset_modifier )
 {
     const std::string &name = escape_property( path ? normalize_relative_path( *path )
                               : "<unknown source file>" );
-    if( stream && stream->eof() ) {
+    if( input.eof() ) {
         switch( error_log_format ) {
             case error_log_format_t::human_readable:
                 return name + ":EOF";
             case error_log_format_t::github_action:
                 return "file=" + name + ",line=EOF";
         }
-    } else if( !stream || stream->fail() ) {
+    } else if( input.fail() ) {
         switch( error_log_format ) {
             case error_log_format_t::human_readable:
                 return name + ":???";
@@ -1859,15 +2048,15 @@ std::string JsonIn::line_number( int offset_modifier )
     char ch;
     seek( 0 );
     for( int i = 0; i < pos + offset_modifier; ++i ) {
-        stream->get( ch );
-        if( !stream->good() ) {
+        input.get( ch );
+        if( !input.good() ) {
             break;
         }
         if( ch == '\r' ) {
             offset = 1;
             ++line;
             if( peek() == '\n' ) {
-                stream->get();
+                input.get();
                 ++i;
             }
         } else if( ch == '\n' ) {
@@ -1903,25 +2092,25 @@ void JsonIn::error( const std::string &message, int offset )
             break;
     }
     // if we can't get more info from the stream don't try
-    if( !stream->good() ) {
+    if( !input.good() ) {
         throw JsonError( err_header.str() + escape_data( message ) );
     }
     // Seek to eof after throwing to avoid continue reading from the incorrect
     // location. The calling code of json error methods is supposed to restore
     // the stream location if it wishes to recover from the error.
     on_out_of_scope seek_to_eof( [this]() {
-        stream->seekg( 0, std::istream::end );
+        input.seekg( 0, std::istream::end );
     } );
     std::ostringstream err;
     err << message;
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg( offset, std::istream::cur );
+    input.seekg( offset, std::istream::cur );
     size_t pos = tell();
     rewind( 3, 240 );
     size_t startpos = tell();
     std::string buffer( pos - startpos, '\0' );
-    stream->read( buffer.data(), pos - startpos );
+    input.read( buffer.data(), pos - startpos );
     auto it = buffer.begin();
     for( ; it < buffer.end() && ( *it == '\r' || *it == '\n' ); ++it ) {
         // skip starting newlines
@@ -1949,30 +2138,30 @@ void JsonIn::error( const std::string &message, int offset )
     err << "^\n";
     seek( pos );
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
+    char ch = input.get();
     if( ch == '\r' ) {
         if( peek() == '\n' ) {
-            stream->get();
+            input.get();
         }
     } else if( ch == '\n' ) {
         // pass
-    } else if( peek() != '\r' && peek() != '\n' && !stream->eof() ) {
+    } else if( peek() != '\r' && peek() != '\n' && !input.eof() ) {
         for( size_t i = 0; i < pos - startpos + 1; ++i ) {
             err << ' ';
         }
     }
     // print the next couple lines as well
     int line_count = 0;
-    for( int i = 0; line_count < 3 && stream->good() && i < 240; ++i ) {
-        stream->get( ch );
-        if( !stream->good() ) {
+    for( int i = 0; line_count < 3 && input.good() && i < 240; ++i ) {
+        input.get( ch );
+        if( !input.good() ) {
             break;
         }
         if( ch == '\r' ) {
             ch = '\n';
             ++line_count;
-            if( stream->peek() == '\n' ) {
-                stream->get( ch );
+            if( input.peek() == '\n' ) {
+                input.get( ch );
             }
         } else if( ch == '\n' ) {
             ++line_count;
@@ -1990,11 +2179,11 @@ void JsonIn::string_error( const std::string &message, const int offset )
 {
     if( test_string() ) {
         // skip quote mark
-        stream->ignore();
+        input.ignore();
         std::string s;
         std::string err;
         for( int i = 0; i < offset; ++i ) {
-            if( !get_escaped_or_unicode( *stream, s, err ) ) {
+            if( !get_escaped_or_unicode( input, s, err ) ) {
                 break;
             }
         }
@@ -2021,15 +2210,15 @@ void JsonIn::rewind( int max_lines, int max_chars )
         return;
     }
     int lines_found = 0;
-    stream->seekg( -1, std::istream::cur );
+    input.seekg( -1, std::istream::cur );
     for( int i = 0; i < max_chars; ++i ) {
         size_t tellpos = tell();
         if( peek() == '\n' ) {
             ++lines_found;
             if( tellpos > 0 ) {
-                stream->seekg( -1, std::istream::cur );
+                input.seekg( -1, std::istream::cur );
                 if( peek() != '\r' ) {
-                    stream->seekg( 1, std::istream::cur );
+                    input.seekg( 1, std::istream::cur );
                 } else {
                     --tellpos;
                 }
@@ -2040,18 +2229,18 @@ void JsonIn::rewind( int max_lines, int max_chars )
         if( lines_found == max_lines ) {
             // don't include the last \n or \r
             if( peek() == '\n' ) {
-                stream->seekg( 1, std::istream::cur );
+                input.seekg( 1, std::istream::cur );
             } else if( peek() == '\r' ) {
-                stream->seekg( 1, std::istream::cur );
+                input.seekg( 1, std::istream::cur );
                 if( peek() == '\n' ) {
-                    stream->seekg( 1, std::istream::cur );
+                    input.seekg( 1, std::istream::cur );
                 }
             }
             break;
         } else if( tellpos == 0 ) {
             break;
         }
-        stream->seekg( -1, std::istream::cur );
+        input.seekg( -1, std::istream::cur );
     }
 }
 
@@ -2059,44 +2248,111 @@ std::string JsonIn::substr( size_t pos, size_t len )
 {
     std::string ret;
     if( len == std::string::npos ) {
-        stream->seekg( 0, std::istream::end );
+        input.seekg( 0, std::istream::end );
         size_t end = tell();
         len = end - pos;
     }
     ret.resize( len );
-    stream->seekg( pos );
-    stream->read( ret.data(), len );
+    input.seekg( pos );
+    input.read( ret.data(), len );
     return ret;
 }
 
+void json_output::write( const char *s, size_t count )
+{
+    if( stream ) {
+        stream->write( s, count );
+    } else if( pos == buffer->size() ) {
+        buffer->append( s, count );
+        pos += count;
+    } else {
+        const size_t overwritten = std::min( count, buffer->size() - pos );
+        buffer->replace( pos, overwritten, s, count );
+        pos += count;
+    }
+}
+
+void json_output::fill( char ch, size_t count )
+{
+    if( stream ) {
+        std::fill_n( std::ostream_iterator<char>( *stream ), count, ch );
+    } else if( pos == buffer->size() ) {
+        buffer->append( count, ch );
+        pos += count;
+    } else {
+        const size_t overwritten = std::min( count, buffer->size() - pos );
+        buffer->replace( pos, overwritten, count, ch );
+        pos += count;
+    }
+}
+
+int json_output::tellp()
+{
+    if( stream ) {
+        return stream->tellp();
+    }
+    return pos;
+}
+
+void json_output::seekp( int new_pos )
+{
+    if( stream ) {
+        stream->clear();
+        stream->seekp( new_pos );
+    } else {
+        pos = std::clamp<size_t>( new_pos, 0, buffer->size() );
+    }
+}
+
 JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
-    stream( &s ), pretty_print( pretty ), indent_level( depth )
+    output( s ), pretty_print( pretty ), indent_level( depth )
 {
-    // ensure consistent and locale-independent formatting of numerals
-    stream->imbue( std::locale::classic() );
-    stream->setf( std::ios_base::showpoint );
-    stream->setf( std::ios_base::dec, std::ostream::basefield );
-    stream->setf( std::ios_base::fixed, std::ostream::floatfield );
+    // Numbers are formatted by JsonOut itself, but callers may keep writing to the stream
+    // afterwards and rely on it being locale-independent.
+    s.imbue( std::locale::classic() );
+    s.setf( std::ios_base::showpoint );
+    s.setf( std::ios_base::dec, std::ostream::basefield );
+    s.setf( std::ios_base::fixed, std::ostream::floatfield );
+    s.setf( std::ios_base::boolalpha );
+}
 
-    // automatically stringify bool to "true" or "false"
-    stream->setf( std::ios_base::boolalpha );
+JsonOut::JsonOut( std::string &buffer, bool pretty, int depth ) :
+    output( buffer ), pretty_print( pretty ), indent_level( depth )
+{
 }
 
 int JsonOut::tell()
 {
-    return stream->tellp();
+    return output.tellp();
 }
 
 void JsonOut::seek( int pos )
 {
-    stream->clear();
-    stream->seekp( pos );
+    output.seekp( pos );
     need_separator = false;
 }
 
+void JsonOut::write_number( bool val )
+{
+    if( val ) {
+        output.write( "true", 4 );
+    } else {
+        output.write( "false", 5 );
+    }
+}
+
+void JsonOut::write_number( double val )
+{
+    // Enough for the integral digits of DBL_MAX and the six decimals.
+    char buf[std::numeric_limits<double>::max_exponent10 + 16];
+    const std::to_chars_result result = std::to_chars( buf, buf + sizeof( buf ), val,
+                                        std::chars_format::fixed, 6 );
+    output.write( buf, result.ptr - buf );
+}
+
 void JsonOut::write_indent()
 {
-    std::fill_n( std::ostream_iterator<char>( *stream ), indent_level * 2, ' ' );
+    output.fill( ' ', indent_level * 2 );
 }
 
 void JsonOut::write_separator()
@@ -2104,15 +2360,15 @@ void JsonOut::write_separator()
     if( !need_separator ) {
         return;
     }
-    stream->put( ',' );
+    output.put( ',' );
     if( pretty_print ) {
         // Wrap after seperator between objects and between members of top-level objects.
         if( indent_level < 2 || need_wrap.back() ) {
-            stream->put( '\n' );
+            output.put( '\n' );
             write_indent();
         } else {
             // Otherwise pad after commas.
-            stream->put( ' ' );
+            output.put( ' ' );
         }
     }
     need_separator = false;
@@ -2121,9 +2377,9 @@ void JsonOut::write_separator()
 void JsonOut::write_member_separator()
 {
     if( pretty_print ) {
-        stream->write( ": ", 2 );
+        output.write( ": ", 2 );
     } else {
-        stream->put( ':' );
+        output.put( ':' );
     }
     need_separator = false;
 }
@@ -2134,11 +2390,11 @@ void JsonOut::start_pretty()
         indent_level += 1;
         // Wrap after top level object and array opening.
         if( indent_level < 2 || need_wrap.back() ) {
-            stream->put( '\n' );
+            output.put( '\n' );
             write_indent();
         } else {
             // Otherwise pad after opening.
-            stream->put( ' ' );
+            output.put( ' ' );
         }
     }
 }
@@ -2150,11 +2406,11 @@ void JsonOut::end_pretty()
         // Wrap after ending top level array and object.
         // Also wrap in the special case of exiting an array containing an object.
         if( indent_level < 1 || need_wrap.back() ) {
-            stream->put( '\n' );
+            output.put( '\n' );
             write_indent();
         } else {
             // Otherwise pad after ending.
-            stream->put( ' ' );
+            output.put( ' ' );
         }
     }
 }
@@ -2164,7 +2420,7 @@ void JsonOut::start_object( bool wrap )
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '{' );
+    output.put( '{' );
     need_wrap.push_back( wrap );
     start_pretty();
     need_separator = false;
@@ -2174,7 +2430,7 @@ void JsonOut::end_object()
 {
     end_pretty();
     need_wrap.pop_back();
-    stream->put( '}' );
+    output.put( '}' );
     need_separator = true;
 }
 
@@ -2183,7 +2439,7 @@ void JsonOut::start_array( bool wrap )
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '[' );
+    output.put( '[' );
     need_wrap.push_back( wrap );
     start_pretty();
     need_separator = false;
@@ -2193,7 +2449,7 @@ void JsonOut::end_array()
 {
     end_pretty();
     need_wrap.pop_back();
-    stream->put( ']' );
+    output.put( ']' );
     need_separator = true;
 }
 
@@ -2202,7 +2458,7 @@ void JsonOut::write_null()
     if( need_separator ) {
         write_separator();
     }
-    stream->write( "null", 4 );
+    output.write( "null", 4 );
     need_separator = true;
 }
 
@@ -2211,41 +2467,43 @@ void JsonOut::write( const std::string &val )
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '"' );
-    for( const auto &i : val ) {
+    output.put( '"' );
+    const char *run_start = val.data();
+    for( const char &i : val ) {
         unsigned char ch = i;
+        if( ch >= 0x20 && ch != '"' && ch != '\\' ) {
+            continue;
+        }
+        output.write( run_start, &i - run_start );
+        run_start = &i + 1;
         if( ch == '"' ) {
-            stream->write( "\\\"", 2 );
+            output.write( "\\\"", 2 );
         } else if( ch == '\\' ) {
-            stream->write( "\\\\", 2 );
-        } else if( ch == '/' ) {
-            // don't technically need to escape this
-            stream->put( '/' );
+            output.write( "\\\\", 2 );
         } else if( ch == '\b' ) {
-            stream->write( "\\b", 2 );
+            output.write( "\\b", 2 );
         } else if( ch == '\f' ) {
-            stream->write( "\\f", 2 );
+            output.write( "\\f", 2 );
         } else if( ch == '\n' ) {
-            stream->write( "\\n", 2 );
+            output.write( "\\n", 2 );
         } else if( ch == '\r' ) {
-            stream->write( "\\r", 2 );
+            output.write( "\\r", 2 );
         } else if( ch == '\t' ) {
-            stream->write( "\\t", 2 );
+            output.write( "\\t", 2 );
         } else if( ch < 0x20 ) {
             // convert to "\uxxxx" unicode escape
-            stream->write( "\\u00", 4 );
-            stream->put( ( ch < 0x10 ) ? '0' : '1' );
+            output.write( "\\u00", 4 );
+            output.put( ( ch < 0x10 ) ? '0' : '1' );
             char remainder = ch & 0x0F;
             if( remainder < 0x0A ) {
-                stream->put( '0' + remainder );
+                output.put( '0' + remainder );
             } else {
-                stream->put( 'A' + ( remainder - 0x0A ) );
+                output.put( 'A' + ( remainder - 0x0A ) );
             }
-        } else {
-            stream->put( ch );
         }
     }
-    stream->put( '"' );
+    output.write( run_start, val.data() + val.size() - run_start );
+    output.put( '"' );
     need_separator = true;
 }
 
@@ -2256,12 +2514,9 @@ void JsonOut::write( const std::bitset<N> &b )
         write_separator();
     }
     std::string converted = b.to_string();
-    stream->put( '"' );
-    for( auto &i : converted ) {
-        unsigned char ch = i;
-        stream->put( ch );
-    }
-    stream->put( '"' );
+    output.put( '"' );
+    output.write( converted.data(), converted.size() );
+    output.put( '"' );
     need_separator = true;
 }
 
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <bitset>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -9,6 +10,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -83,11 +85,118 @@ struct number_sci_notation {
     int64_t exp = 0;
 };
 
+/**
+ * Input of a @ref JsonIn, either a std::istream or a buffer holding the whole input.
+ *
+ * Provides the part of the std::istream interface JsonIn uses, with the same eof and
+ * fail semantics, so the parser doesn't care which one it reads.  Buffers are read
+ * directly, without the per-character cost of going through the stream.
+ */
+class json_input
+{
+    public:
+        explicit json_input( std::istream &s ) : stream( &s ) {}
+        explicit json_input( std::string_view buffer ) :
+            begin( buffer.data() ), end( buffer.data() + buffer.size() ), pos( begin ) {}
+
+        bool is_buffer() const {
+            return stream == nullptr;
+        }
+
+        int get() {
+            if( stream ) {
+                return stream->get();
+            }
+            if( !good() || pos == end ) {
+                failed_read();
+                return EOF;
+            }
+            return static_cast<unsigned char>( *pos++ );
+        }
+        bool get( char &ch ) {
+            if( stream ) {
+                return static_cast<bool>( stream->get( ch ) );
+            }
+            if( !good() || pos == end ) {
+                failed_read();
+                return false;
+            }
+            ch = *pos++;
+            return true;
+        }
+        /** Reads up to @p count - 1 characters, stopping before a newline. */
+        bool get( char *s, int count );
+        int peek() {
+            if( stream ) {
+                return stream->peek();
+            }
+            if( !good() ) {
+                fail_bit = true;
+                return EOF;
+            }
+            if( pos == end ) {
+                eof_bit = true;
+                return EOF;
+            }
+            return static_cast<unsigned char>( *pos );
+        }
+        void ignore();
+        void unget();
+        void read( char *s, size_t count );
+
+        int tellg();
+        void seekg( int offset, std::ios_base::seekdir dir = std::ios_base::beg );
+
+        bool good() const {
+            return stream ? stream->good() : !eof_bit && !fail_bit;
+        }
+        bool eof() const {
+            return stream ? stream->eof() : eof_bit;
+        }
+        bool fail() const {
+            return stream ? stream->fail() : fail_bit;
+        }
+        void clear() {
+            if( stream ) {
+                stream->clear();
+            } else {
+                eof_bit = false;
+                fail_bit = false;
+            }
+        }
+
+        /** Buffer only: skips JSON whitespace, like peeking and getting it one by one would. */
+        void skip_whitespace();
+        /**
+         * Buffer only: takes the run of following characters that stand for themselves
+         * inside a JSON string, ASCII other than control characters, quotes and backslashes.
+         */
+        std::string_view take_plain_string_chars();
+
+    private:
+        void failed_read() {
+            if( good() ) {
+                eof_bit = true;
+            }
+            fail_bit = true;
+        }
+
+        std::istream *stream = nullptr;
+        const char *begin = nullptr;
+        const char *end = nullptr;
+        const char *pos = nullptr;
+        bool eof_bit = false;
+        bool fail_bit = false;
+};
+
 /* JsonIn
  * ======
  *
  * The JsonIn class provides a wrapper around a std::istream,
  * with methods for reading JSON data directly from the stream.
+ * It can also read from a buffer holding the whole input, which is faster
+ * than going through a stream and should be preferred when the data is
+ * already in memory.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -166,7 +275,7 @@ struct number_sci_notation {
 class JsonIn
 {
     private:
-        std::istream *stream;
+        json_input input;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
 
@@ -175,11 +284,19 @@ class JsonIn
         void end_value();
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
+        JsonIn( std::istream &s ) : input( s ) {}
         JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
+            : input( s ), path( make_shared_fast<std::string>( path ) ) {}
         JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
+            : input( s ), path( loc.path ) {
+            seek( loc.offset );
+        }
+        /** Reads from @p buffer, which must outlive this JsonIn and any JsonObject read from it. */
+        explicit JsonIn( std::string_view buffer ) : input( buffer ) {}
+        JsonIn( std::string_view buffer, const std::string &path )
+            : input( buffer ), path( make_shared_fast<std::string>( path ) ) {}
+        JsonIn( std::string_view buffer, const json_source_location &loc )
+            : input( buffer ), path( loc.path ) {
             seek( loc.offset );
         }
         JsonIn( const JsonIn & ) = delete;
@@ -591,12 +708,49 @@ class JsonIn
         number_sci_notation get_any_int();
 };
 
+/**
+ * Output of a @ref JsonOut, either a std::ostream or a string the JSON is appended to.
+ *
+ * Writing into a string skips the stream machinery for every token, and lets callers
+ * keep one buffer around and reuse its capacity for each file they write.
+ */
+class json_output
+{
+    public:
+        explicit json_output( std::ostream &s ) : stream( &s ) {}
+        explicit json_output( std::string &buffer ) : buffer( &buffer ), pos( buffer.size() ) {}
+
+        void put( char ch ) {
+            if( stream ) {
+                stream->put( ch );
+            } else if( pos == buffer->size() ) {
+                buffer->push_back( ch );
+                pos++;
+            } else {
+                ( *buffer )[pos++] = ch;
+            }
+        }
+        void write( const char *s, size_t count );
+        /** Writes @p count copies of @p ch. */
+        void fill( char ch, size_t count );
+
+        int tellp();
+        void seekp( int pos );
+
+    private:
+        std::ostream *stream = nullptr;
+        std::string *buffer = nullptr;
+        /** Write position in @ref buffer, only before the end after seeking back. */
+        size_t pos = 0;
+};
+
 /* JsonOut
  * =======
  *
  * The JsonOut class provides a straightforward interface for outputting JSON.
  *
- * It wraps a std::ostream, providing methods for writing JSON data directly.
+ * It wraps a std::ostream or a std::string buffer, providing methods for writing
+ * JSON data directly.
  *
  * Typical usage might be as follows:
  *
@@ -623,7 +777,7 @@ class JsonIn
 class JsonOut
 {
     private:
-        std::ostream *stream;
+        json_output output;
         bool pretty_print;
         std::vector<bool> need_wrap;
         int indent_level = 0;
@@ -631,6 +785,8 @@ class JsonOut
 
     public:
         JsonOut( std::ostream &stream, bool pretty_print = false, int depth = 0 );
+        /** Appends the JSON to @p buffer. */
+        explicit JsonOut( std::string &buffer, bool pretty_print = false, int depth = 0 );
         JsonOut( const JsonOut & ) = delete;
         JsonOut &operator=( const JsonOut & ) = delete;
 
@@ -644,9 +800,6 @@ class JsonOut
         void set_need_separator() {
             need_separator = true;
         }
-        std::ostream *get_stream() {
-            return stream;
-        }
         int tell();
         void seek( int pos );
         void start_pretty();
@@ -660,12 +813,31 @@ class JsonOut
         // write data to the output stream as JSON
         void write_null();
 
+    private:
+        // Same text a stream with fixed, showpoint and boolalpha in the classic locale produces
+        void write_number( bool val );
+        void write_number( double val );
+        void write_number( float val ) {
+            write_number( static_cast<double>( val ) );
+        }
+        void write_number( long double val ) {
+            write_number( static_cast<double>( val ) );
+        }
+        template <typename T>
+        void write_number( T val ) requires std::is_integral_v<T> {
+            char buf[24];
+            const std::to_chars_result result = std::to_chars( buf, buf + sizeof( buf ), val );
+            output.write( buf, result.ptr - buf );
+        }
+
+    public:
+
         template <typename T>
-        void write( T val ) requires std::is_fundamental_v<T> {
+        void write( T val ) requires std::is_arithmetic_v<T> {
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            write_number( val );
             need_separator = true;
         }
 
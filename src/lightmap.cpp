@@ -2,11 +2,17 @@
 #include "shadowcasting.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -102,6 +108,16 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
     }
 }
 
+void map::update_weather_transparency_lookup()
+{
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+}
+
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
@@ -126,10 +142,7 @@ bool map::build_transparency_cache( const int zlev )
 
     const float sight_penalty = get_weather().weather_id->sight_penalty;
 
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
+    update_weather_transparency_lookup();
 
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
@@ -636,13 +649,7 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
-        }
-    }
+    apply_buffered_light_sources( zlev );
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
@@ -1191,6 +1198,77 @@ static inline bool eq_nullptr_gcc_hack( const void *check )
     return check == nullptr;
 }
 
+// fast_rl_dist<21, 4> of ( -x, -y ) for every delta a castLight row can reach, indexed [y][x].
+static constexpr auto fast_rl_dist_rows = []() {
+    std::array<std::array<std::uint8_t, 61>, 61> rows{};
+    for( int y = 0; y < 61; y++ ) {
+        for( int x = 0; x <= y; x++ ) {
+            const int val = x * x + y * y;
+            int a = val;
+            if( val >= 2 ) {
+                a = 21;
+                for( int i = 0; i < 4; i++ ) {
+                    a = ( a + val / a ) / 2;
+                }
+            }
+            rows[y][x] = static_cast<std::uint8_t>( a );
+        }
+    }
+    return rows;
+}();
+
+// Rows can only be lit in batches when the output takes a plain maximum, regardless of quadrant.
+template<typename T, typename Out, void( *update_output )( Out &, const T &, quadrant )>
+static constexpr bool updates_by_max()
+{
+    if constexpr( std::is_same_v<T, float> && std::is_same_v<Out, float> ) {
+        return update_output == &update_light;
+    } else {
+        return false;
+    }
+}
+
+// Lights the run of cells starting at current and stepping along y by yx that are not blocked
+// and have the given transparency, on a fast path. Returns the number of cells lit.
+template<int yx, typename T, T( *lookup_calc )( const T &, const T &, const int & ), typename Blocked>
+static int castLight_row_run( float( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                              const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                              const Blocked &check_blocked, const transparency_exp_lookup<90> *lookup,
+                              const point &current, tripoint delta, const int max_cells,
+                              const int offsetDistance, const T numerator, const T transparency,
+                              T &last_intensity )
+{
+    const int in_bounds = yx > 0 ? MAPSIZE_Y - current.y : current.y + 1;
+    int run = std::min( max_cells, in_bounds );
+    if( yx > 0 ) {
+        run = shadowcasting_rows::count_equal_forward( &input_array[current.x][current.y], run,
+                transparency );
+    } else {
+        run = shadowcasting_rows::count_equal_backward( &input_array[current.x][current.y], run,
+                transparency );
+    }
+    // The first cell was checked by the caller
+    for( int i = 1; i < run; i++ ) {
+        if( check_blocked( point( current.x, current.y + i * yx ) ) ) {
+            run = i;
+            break;
+        }
+    }
+
+    // Intensities in memory order, so they can be merged into the output in one pass
+    float intensities[MAPSIZE_Y];
+    const std::array<std::uint8_t, 61> &row_dist = fast_rl_dist_rows[-delta.y];
+    for( int i = 0; i < run; i++ ) {
+        const int dist = ( trigdist ? row_dist[-delta.x] : -delta.y ) + offsetDistance;
+        last_intensity = lookup_calc( numerator, lookup->values[dist], dist );
+        intensities[yx > 0 ? i : run - 1 - i] = last_intensity;
+        delta.x++;
+    }
+    const int first_y = yx > 0 ? current.y : current.y - run + 1;
+    shadowcasting_rows::max_into( &output_cache[current.x][first_y], intensities, run );
+    return run;
+}
+
 template<int xx, int xy, int yx, int yy, typename T, typename Out,
          T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
@@ -1241,6 +1319,12 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         cata::unreachable();
     };
 
+    // Rows of these octants run along y, which is contiguous in the caches.
+    // Negative offsets would cast further than the precomputed distances reach.
+    constexpr bool batch_rows = xx == 0 && updates_by_max<T, Out, update_output>();
+    const bool use_batches = batch_rows && !eq_nullptr_gcc_hack( lookup ) && offsetDistance >= 0 &&
+                             get_shadowcasting_kernel() != shadowcasting_kernel::per_cell;
+
     int radius = 60 - offsetDistance;
     if( start < end ) {
         return;
@@ -1277,6 +1361,17 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                 started_row = true;
                 current_transparency = input_array[ current.x ][ current.y ];
             }
+            if constexpr( batch_rows ) {
+                // Cells matching the current transparency only get lit, so light the whole run at once.
+                if( use_batches && input_array[ current.x ][ current.y ] == current_transparency ) {
+                    const int run = castLight_row_run<yx, T, lookup_calc>(
+                                        output_cache, input_array, check_blocked, lookup, current, delta,
+                                        x_limit - delta.x + 1, offsetDistance, numerator, current_transparency,
+                                        last_intensity );
+                    delta.x += run - 1;
+                    continue;
+                }
+            }
             if( !eq_nullptr_gcc_hack( lookup ) ) {
                 //Only use fast dist on fast paths, it's slower otherwise. Floating point conversion thing maybe?
                 const int dist = fast_rl_dist<21, 4>( delta ) + offsetDistance;
@@ -1749,85 +1844,241 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
-{
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
+// Directions in which a light source needs to cast light, see light_directions
+enum light_direction : int {
+    light_north = 1 << 0,
+    light_south = 1 << 1,
+    light_east = 1 << 2,
+    light_west = 1 << 3,
+};
 
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
-    if( luminance <= lit_level::LOW ) {
-        return;
-    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
-    }
-
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
-
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
+/* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+     neighboring fires to the north and west that were applied via light_source_buffer
+   If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+   If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+     add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+      ey
+    nnnNnnn
+    w     e
+    w  5 +e
+ sx W 5*1+E ex
+    w ++++e
+    w+++++e
+    sssSsss
+       sy
+*/
+static int light_directions( const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                             const point &p, const float luminance )
+{
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance );
-    bool south = ( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance );
-    bool east = ( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance );
-    bool west = ( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance );
+    int directions = 0;
+    if( p.y != 0 && light_source_buffer[p.x][p.y - 1] < luminance ) {
+        directions |= light_north;
+    }
+    if( p.y != peer_inbounds && light_source_buffer[p.x][p.y + 1] < luminance ) {
+        directions |= light_south;
+    }
+    if( p.x != peer_inbounds && light_source_buffer[p.x + 1][p.y] < luminance ) {
+        directions |= light_east;
+    }
+    if( p.x != 0 && light_source_buffer[p.x - 1][p.y] < luminance ) {
+        directions |= light_west;
+    }
+    return directions;
+}
+
+// Casts the light of a source at p into lm. Reads only the transparency and diagonal blocks of cache.
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               const level_cache &cache, const point &p, const float luminance,
+                               const int directions )
+{
+    const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
 
-    if( north ) {
+    if( directions & light_north ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
         castLightWithLookup < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & light_east ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
         castLightWithLookup < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
     }
 
-    if( south ) {
+    if( directions & light_south ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
         castLightWithLookup < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & light_west ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
         castLightWithLookup < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
-                                lm, transparency_cache, blocked_cache, p2, 0, luminance );
+                                lm, transparency_cache, blocked_cache, p, 0, luminance );
+    }
+}
+
+// Lights the source's own tile and returns the luminance its light should be cast with,
+// or 0 if it's too dim to light anything else.
+static float light_source_center( level_cache &cache, const point &p, const bool in_bounds,
+                                  const float luminance )
+{
+    if( in_bounds ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        cache.lm[p.x][p.y] = elementwise_max( cache.lm[p.x][p.y], min_light );
+        cache.sm[p.x][p.y] = std::max( cache.sm[p.x][p.y], luminance );
+    }
+    if( luminance <= lit_level::LOW ) {
+        return 0.0f;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        return 1.49f;
+    }
+    return luminance;
+}
+
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    const point p2( p.xy() );
+
+    luminance = light_source_center( cache, p2, inbounds( p ), luminance );
+    if( luminance <= 0.0f ) {
+        return;
     }
+    cast_light_source( cache.lm, cache, p2, luminance,
+                       light_directions( cache.light_source_buffer, p2, luminance ) );
+}
+
+// Casts a light source on an empty lightmap and records what it lit.
+static cached_light_source record_light_source( const level_cache &cache, const point &p,
+        const float luminance, const int directions )
+{
+    // Kept zeroed between calls, only the lit tiles are reset
+    static four_quadrants scratch[MAPSIZE_X][MAPSIZE_Y];
+    cast_light_source( scratch, cache, p, luminance, directions );
+
+    cached_light_source result;
+    point min = p;
+    point max = p;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            four_quadrants &light = scratch[x][y];
+            if( light.max() <= 0.0f ) {
+                continue;
+            }
+            result.lit.emplace_back( point( x, y ), light );
+            light.fill( 0.0f );
+            min.x = std::min( min.x, x );
+            min.y = std::min( min.y, y );
+            max.x = std::max( max.x, x );
+            max.y = std::max( max.y, y );
+        }
+    }
+
+    // Shadowcasting also visits tiles it doesn't light: ones skipped because of diagonal blocks,
+    // and their neighbours. Runs of those are short, so a submap of margin covers them.
+    min = point( std::max( min.x - SEEX, 0 ), std::max( min.y - SEEY, 0 ) );
+    max = point( std::min( max.x + SEEX, MAPSIZE_X - 1 ), std::min( max.y + SEEY, MAPSIZE_Y - 1 ) );
+    for( int smx = min.x / SEEX; smx <= max.x / SEEX; smx++ ) {
+        for( int smy = min.y / SEEY; smy <= max.y / SEEY; smy++ ) {
+            result.footprint.set( smx * MAPSIZE + smy );
+        }
+    }
+    return result;
+}
+
+// Returns the submaps whose transparency or diagonal blocks changed since the cached light
+// sources were cast, and remembers the current ones.
+static std::bitset<MAPSIZE *MAPSIZE> update_cached_light_dependencies( level_cache &cache )
+{
+    std::bitset<MAPSIZE *MAPSIZE> changed;
+    for( int smx = 0; smx < MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < MAPSIZE; smy++ ) {
+            const int y = smy * SEEY;
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                if( std::memcmp( &cache.transparency_cache[x][y], &cache.cached_light_transparency[x][y],
+                                 sizeof( float ) * SEEY ) != 0 ||
+                    std::memcmp( &cache.vehicle_obscured_cache[x][y], &cache.cached_light_obscured[x][y],
+                                 sizeof( diagonal_blocks ) * SEEY ) != 0 ) {
+                    changed.set( smx * MAPSIZE + smy );
+                    break;
+                }
+            }
+        }
+    }
+
+    // Re-casting most sources one by one would be slower than just casting them all
+    if( changed.count() > changed.size() / 2 ||
+        cache.cached_light_weather_transparency != weather_transparency_lookup.transparency ||
+        cache.cached_light_trigdist != trigdist ) {
+        cache.cached_light_sources.clear();
+    }
+
+    std::memcpy( cache.cached_light_transparency, cache.transparency_cache,
+                 sizeof( cache.transparency_cache ) );
+    std::memcpy( cache.cached_light_obscured, cache.vehicle_obscured_cache,
+                 sizeof( cache.vehicle_obscured_cache ) );
+    cache.cached_light_weather_transparency = weather_transparency_lookup.transparency;
+    cache.cached_light_trigdist = trigdist;
+    return changed;
+}
+
+void map::apply_buffered_light_sources( const int zlev )
+{
+    ZoneScoped;
+    level_cache &cache = get_cache( zlev );
+    const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+    std::map<std::tuple<point, float, int>, cached_light_source> &cached = cache.cached_light_sources;
+
+    const std::bitset<MAPSIZE *MAPSIZE> changed = update_cached_light_dependencies( cache );
+    for( auto &source : cached ) {
+        source.second.used = false;
+    }
+
+    for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+            if( light_source_buffer[x][y] <= 0.0f ) {
+                continue;
+            }
+            const point p( x, y );
+            const float luminance = light_source_center( cache, p, true, light_source_buffer[x][y] );
+            if( luminance <= 0.0f ) {
+                continue;
+            }
+            const int directions = light_directions( light_source_buffer, p, luminance );
+            const std::tuple<point, float, int> key( p, luminance, directions );
+            auto iter = cached.find( key );
+            if( iter == cached.end() || ( iter->second.footprint & changed ).any() ) {
+                iter = cached.insert_or_assign( key, record_light_source( cache, p, luminance,
+                                                directions ) ).first;
+            }
+            iter->second.used = true;
+            // Light is combined by taking the maximum, so the order sources are applied in doesn't matter
+            for( const std::pair<point, four_quadrants> &lit : iter->second.lit ) {
+                four_quadrants &light = cache.lm[lit.first.x][lit.first.y];
+                light = elementwise_max( light, lit.second );
+            }
+        }
+    }
+
+    std::erase_if( cached, []( const auto & source ) {
+        return !source.second.used;
+    } );
 }
 
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
@@ -508,9 +508,10 @@ void main_menu::init_strings()
     vWorldSubItems.emplace_back( pgettext( "Main Menu|World", "Reset World" ) );
     vWorldSubItems.emplace_back( pgettext( "Main Menu|World", "Delete World" ) );
     vWorldSubItems.emplace_back( pgettext( "Main Menu|World", "Convert to V2 Save Format" ) );
+    vWorldSubItems.emplace_back( pgettext( "Main Menu|World", "Convert to Fast Save Compression" ) );
     vWorldSubItems.emplace_back( pgettext( "Main Menu|World", "<= Return" ) );
 
-    vWorldHotkeys = { 'm', 'e', 's', 't', 'r', 'd', 'f', 'q' };
+    vWorldHotkeys = { 'm', 'e', 's', 't', 'r', 'd', 'f', 'z', 'q' };
 
     vSettingsSubItems.clear();
     vSettingsSubItems.emplace_back( pgettext( "Main Menu|Settings", "<O|o>ptions" ) );
@@ -1136,7 +1137,21 @@ void main_menu::world_tab( const std::string &worldname )
         world_generator->convert_to_v2( worldname );
     };
 
+    auto convert_lz4 = [this, &worldname]() {
+        world_generator->set_active_world( nullptr );
+        savegames.clear();
+        MAPBUFFER.clear();
+        overmap_buffer.clear();
+        world_generator->convert_to_lz4( worldname );
+    };
+
     switch( opt_val ) {
+        case 7: // Convert to Fast Save Compression
+            if( query_yn(
+                    _( "Recompress the world with a faster codec?  Saves will get somewhat larger.  Conversion may take several minutes." ) ) ) {
+                convert_lz4();
+            }
+            break;
         case 6: // Convert to V2 Save Format
             if( query_yn(
                     _( "Convert to V2 Save Format? A backup will be created. Conversion may take several minutes." ) ) ) {
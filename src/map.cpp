@@ -75,6 +75,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "legacy_pathfinding.h"
+#include "pathfinding.h"
 #include "player.h"
 #include "point_float.h"
 #include "projectile.h"
@@ -86,6 +87,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
@@ -1521,6 +1523,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
 
     // TODO: Limit to changes that affect move cost, traps and stairs
     set_pathfinding_cache_dirty( p.z );
+    Pathfinding::mark_dirty_cluster( getabs( p ) );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1856,6 +1859,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
 
     // TODO: Limit to changes that affect move cost, traps and stairs
     set_pathfinding_cache_dirty( p.z );
+    Pathfinding::mark_dirty_cluster( getabs( p ) );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -5032,7 +5036,7 @@ bool map::has_items( const tripoint &p ) const
     point l;
     submap *const current_submap = get_submap_at( p, l );
 
-    return !current_submap->get_items( l ).empty();
+    return current_submap->has_items( l );
 }
 
 template <typename Stack>
@@ -7049,6 +7053,8 @@ void map::shift( point sp )
     if( sp == point_zero ) {
         return; // Skip this?
     }
+    // Cached sight is keyed by map square
+    Creature::invalidate_sight_cache();
 
     if( std::abs( sp.x ) > 1 || std::abs( sp.y ) > 1 ) {
         debugmsg( "map::shift called with a shift of more than one submap" );
@@ -7269,12 +7275,46 @@ static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
     }
 }
 
-void map::loadn( const tripoint &grid, const bool update_vehicles )
+// Runs mapgen for the overmap terrain tile containing @p abs_sub, which must not exist yet
+// @returns true if full mapgen was run, false if the tile was filled in with a single terrain
+static bool generate_omt( const tripoint &abs_sub )
 {
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
+    // Each overmap square is two nonants; to prevent overlap, generate only at
+    //  squares divisible by 2.
+    // TODO: fix point types
+    const tripoint_abs_omt abs_omt( sm_to_omt_copy( abs_sub ) );
+    const tripoint abs_sub_rounded = omt_to_sm_copy( abs_omt.raw() );
+
+    const oter_id terrain_type = overmap_buffer.ter( abs_omt );
+
+    // Short-circuit if the map tile is uniform
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == air ) {
+        generate_uniform( abs_sub_rounded, t_open_air );
+        return false;
+    } else if( terrain_type == rock ) {
+        generate_uniform( abs_sub_rounded, t_rock );
+        return false;
+    }
+    tinymap tmp_map;
+    tmp_map.generate( abs_sub_rounded, calendar::turn );
+    return true;
+}
+
+bool map::generate_missing_omt( const tripoint &abs_sub )
+{
+    if( MAPBUFFER.lookup_submap( abs_sub ) != nullptr ) {
+        return false;
+    }
+    return generate_omt( abs_sub );
+}
+
+void map::loadn( const tripoint &grid, const bool update_vehicles )
+{
     const tripoint grid_abs_sub = abs_sub.xy() + grid;
     const size_t gridn = get_nonant( grid );
 
@@ -7285,25 +7325,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     if( tmpsub == nullptr ) {
         // It doesn't exist; we must generate it!
         dbg( DL::Info ) << "map::loadn: Missing mapbuffer data.  Regenerating.";
-
-        // Each overmap square is two nonants; to prevent overlap, generate only at
-        //  squares divisible by 2.
-        // TODO: fix point types
-        const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
-        const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
-
-        const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
-
-        // Short-circuit if the map tile is uniform
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == air ) {
-            generate_uniform( grid_abs_sub_rounded, t_open_air );
-        } else if( terrain_type == rock ) {
-            generate_uniform( grid_abs_sub_rounded, t_rock );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
-        }
+        generate_omt( grid_abs_sub );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
@@ -7319,6 +7341,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     set_outside_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
     set_pathfinding_cache_dirty( grid.z );
+    Pathfinding::mark_dirty_submap( grid_abs_sub );
     set_suspension_cache_dirty( grid.z );
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
@@ -7791,7 +7814,7 @@ void map::actualize( const tripoint &grid )
                 field_furn_locs.push_back( pnt );
             }
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+            if( tmpsub->has_items( p ) && !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
                 temperature_flag temperature = temperature_flag_at_point( *this, pnt );
                 remove_rotten_items( tmpsub->get_items( { x, y } ), pnt, temperature );
             }
@@ -8590,25 +8613,62 @@ void map::do_vehicle_caching( int z )
     }
 }
 
+bool map::build_level_caches( const int zlev, const bool affects_seen_cache )
+{
+    ZoneScoped;
+    build_outside_cache( zlev );
+    build_transparency_cache( zlev );
+    bool seen_cache_dirty = build_floor_cache( zlev ) && affects_seen_cache;
+    seen_cache_dirty |= get_cache( zlev ).seen_cache_dirty && affects_seen_cache;
+    diagonal_blocks fill = {false, false};
+    std::uninitialized_fill_n( &( get_cache( zlev ).vehicle_obscured_cache[0][0] ),
+                               MAPSIZE_X * MAPSIZE_Y, fill );
+    std::uninitialized_fill_n( &( get_cache( zlev ).vehicle_obstructed_cache[0][0] ),
+                               MAPSIZE_X * MAPSIZE_Y, fill );
+    return seen_cache_dirty;
+}
+
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     ZoneScoped;
+    // Sight is checked against the built caches, so results only go stale once they are rebuilt
+    Creature::invalidate_sight_cache();
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
+    // Levels only depend on their own cache and on the submaps of the level below,
+    // which are not modified here, so they can be built concurrently.
+    // Missing submaps would make the builders report errors from worker threads.
+    const bool parallel = parallel_map_cache && zlevels && std::ranges::all_of( grid,
+    []( const submap * sm ) {
+        return sm != nullptr;
+    } );
+    if( parallel ) {
+        update_weather_transparency_lookup();
+        cata::thread_pool &pool = cata::get_thread_pool();
+        std::vector<std::future<bool>> levels;
+        for( int z = minz; z <= maxz; z++ ) {
+            // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
+            const bool affects_seen_cache = z == zlev || fov_3d;
+            levels.push_back( pool.submit( [this, z, affects_seen_cache]() {
+                return build_level_caches( z, affects_seen_cache );
+            }, cata::task_priority::high, "build_level_caches" ) );
+        }
+        // Collect in z order so the result doesn't depend on scheduling
+        for( std::future<bool> &level : levels ) {
+            pool.help_until_ready( level );
+            seen_cache_dirty |= level.get();
+        }
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
+            const bool affects_seen_cache = z == zlev || fov_3d;
+            seen_cache_dirty |= build_level_caches( z, affects_seen_cache );
+        }
+    }
+    // Suspension checks mark tiles for the support pass, which is shared between levels
     for( int z = minz; z <= maxz; z++ ) {
-        // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
-        const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
         update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
-        seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
-        diagonal_blocks fill = {false, false};
-        std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
-                                   fill );
-        std::uninitialized_fill_n( &( get_cache( z ).vehicle_obstructed_cache[0][0] ),
-                                   MAPSIZE_X * MAPSIZE_Y, fill );
     }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
@@ -9168,12 +9228,14 @@ level_cache::level_cache()
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &cached_light_transparency[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
     diagonal_blocks fill = {false, false};
     std::fill_n( &vehicle_obscured_cache[0][0], map_dimensions, fill );
     std::fill_n( &vehicle_obstructed_cache[0][0], map_dimensions, fill );
+    std::fill_n( &cached_light_obscured[0][0], map_dimensions, fill );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, lit_level::DARK );
@@ -9227,6 +9289,7 @@ void map::invalidate_map_cache( const int zlev )
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
         ch.suspension_cache_dirty = true;
+        ch.cached_light_sources.clear();
     }
 }
 
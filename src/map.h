@@ -17,6 +17,7 @@
 
 #include "bodypart.h"
 #include "calendar.h"
+#include "clock_cache.h"
 #include "coordinate_conversions.h"
 #include "coordinates.h"
 #include "enums.h"
@@ -26,7 +27,6 @@
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "point.h"
@@ -294,6 +294,17 @@ struct diagonal_blocks {
     bool ne;
 };
 
+// Light cast by one buffered light source (see map::add_light_source) during map::generate_lightmap.
+// Reused by later generations while the submaps it depends on keep their transparency.
+struct cached_light_source {
+    // Tiles reached by the light and the light they received
+    std::vector<std::pair<point, four_quadrants>> lit;
+    // Submaps whose transparency or diagonal blocks the light depends on
+    std::bitset<MAPSIZE *MAPSIZE> footprint;
+    // Set when the source was present in the last generation, unused ones are dropped
+    bool used = false;
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
@@ -312,6 +323,15 @@ struct level_cache {
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Light of the buffered sources from the previous generate_lightmap,
+    // keyed by position, luminance and the directions the light was cast in
+    std::map<std::tuple<point, float, int>, cached_light_source> cached_light_sources;
+    // Transparency and diagonal blocks the cached light sources were cast with
+    float cached_light_transparency[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks cached_light_obscured[MAPSIZE_X][MAPSIZE_Y];
+    // Weather transparency and trigdist the cached light sources were cast with
+    float cached_light_weather_transparency = 0.0f;
+    bool cached_light_trigdist = false;
 
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
@@ -1556,6 +1576,13 @@ class map
 
         // mapgen.cpp functions
         void generate( const tripoint &p, const time_point &when );
+        /**
+         * Makes sure the overmap terrain tile containing the submap at @p abs_sub
+         * is in the map buffer, loading it from the save or running mapgen for it.
+         * @returns true if full mapgen had to run, false if the tile was already
+         * stored or was cheap to fill in.
+         */
+        static bool generate_missing_omt( const tripoint &abs_sub );
         void place_spawns( const mongroup_id &group, int chance,
                            point p1, point p2, float density,
                            bool individual = false, bool friendly = false, const std::string &name = "NONE",
@@ -1789,6 +1816,13 @@ class map
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_transparency_cache( int zlev );
+        // Updates the weather transparency lookup shared by all z-levels.
+        // Must be done before transparency caches are built concurrently.
+        void update_weather_transparency_lookup();
+        // Builds outside, transparency and floor caches of a single z-level.
+        // Only touches the cache of that level, so different levels may be built in parallel.
+        // Returns true if the seen cache should be rebuilt.
+        bool build_level_caches( int zlev, bool affects_seen_cache );
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1803,6 +1837,9 @@ class map
         void update_suspension_cache( const int &z );
     protected:
         void generate_lightmap( int zlev );
+        // Applies the light sources collected in light_source_buffer, re-casting only those
+        // whose surroundings changed since the previous call.
+        void apply_buffered_light_sources( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1998,7 +2035,7 @@ class map
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable clock_cache<point, char> skew_vision_cache;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
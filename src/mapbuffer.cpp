@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -17,6 +18,7 @@
 #include "game.h"
 #include "game_constants.h"
 #include "json.h"
+#include "line.h"
 #include "map.h"
 #include "output.h"
 #include "popup.h"
@@ -34,6 +36,10 @@ mapbuffer::~mapbuffer() = default;
 void mapbuffer::clear()
 {
     submaps.clear();
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.loads = 0;
+    stats.evictions = 0;
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
@@ -69,18 +75,30 @@ void mapbuffer::remove_submap( tripoint addr )
     submaps.erase( m_target );
 }
 
+submap *mapbuffer::find_submap( const tripoint &p ) const
+{
+    const auto iter = submaps.find( p );
+    return iter == submaps.end() ? nullptr : iter->second.get();
+}
+
 submap *mapbuffer::lookup_submap( const tripoint &p )
 {
     const auto iter = submaps.find( p );
     if( iter == submaps.end() ) {
+        stats.misses.fetch_add( 1, std::memory_order_relaxed );
         try {
-            return unserialize_submaps( p );
+            submap *sm = unserialize_submaps( p );
+            if( sm != nullptr ) {
+                stats.loads.fetch_add( 1, std::memory_order_relaxed );
+            }
+            return sm;
         } catch( const std::exception &err ) {
             debugmsg( "Failed to load submap %s: %s", p.to_string(), err.what() );
         }
         return nullptr;
     }
 
+    stats.hits.fetch_add( 1, std::memory_order_relaxed );
     return iter->second.get();
 }
 
@@ -159,17 +177,22 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr].get();
+        submap *sm = find_submap( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && !delete_after_save ) {
+            // Nothing holds on to item lists between turns, so this is a safe point to drop
+            // the ones that were only looked at
+            sm->shrink_items();
+        }
     }
 
     if( all_uniform ) {
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
+                if( find_submap( submap_addr ) != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -182,15 +205,10 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
-    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
+    g->get_active_world()->write_map_quad( om_addr, [&]( JsonOut & jsout ) {
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
-            if( !submaps.contains( submap_addr ) ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr].get();
+            submap *sm = find_submap( submap_addr );
 
             if( sm == nullptr ) {
                 continue;
@@ -220,6 +238,72 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
     } );
 }
 
+int mapbuffer::evict_cold_submaps( const tripoint &map_origin, size_t limit, int max_quads )
+{
+    if( limit == 0 || submaps.size() <= limit ) {
+        return 0;
+    }
+    // Evict a bit more than strictly needed, so that every map shift past the limit
+    // doesn't end up writing a quad or two.
+    const size_t target = limit - limit / 8;
+
+    // Quads under and right next to the map are either in use or likely to be needed soon.
+    static constexpr int keep_margin = 4;
+    const tripoint origin_omt = sm_to_omt_copy( map_origin );
+    const auto is_kept = [&]( const tripoint & om_addr ) {
+        return om_addr.x >= origin_omt.x - keep_margin &&
+               om_addr.y >= origin_omt.y - keep_margin &&
+               om_addr.x <= origin_omt.x + HALF_MAPSIZE + keep_margin &&
+               om_addr.y <= origin_omt.y + HALF_MAPSIZE + keep_margin;
+    };
+
+    // last_touched is refreshed whenever a submap enters or leaves the reality bubble,
+    // so the quad with the oldest one is the least recently used.
+    std::unordered_map<tripoint, time_point> quad_last_touched;
+    for( const auto &elem : submaps ) {
+        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        if( elem.second == nullptr || is_kept( om_addr ) ) {
+            continue;
+        }
+        auto inserted = quad_last_touched.emplace( om_addr, elem.second->last_touched );
+        if( !inserted.second ) {
+            inserted.first->second = std::max( inserted.first->second, elem.second->last_touched );
+        }
+    }
+
+    std::vector<std::pair<tripoint, time_point>> candidates( quad_last_touched.begin(),
+            quad_last_touched.end() );
+    const auto distance = [&]( const tripoint & om_addr ) {
+        return square_dist( om_addr.xy(), origin_omt.xy() );
+    };
+    std::sort( candidates.begin(), candidates.end(), [&]( const auto & lhs, const auto & rhs ) {
+        if( lhs.second != rhs.second ) {
+            return lhs.second < rhs.second;
+        }
+        if( distance( lhs.first ) != distance( rhs.first ) ) {
+            return distance( lhs.first ) > distance( rhs.first );
+        }
+        return lhs.first < rhs.first;
+    } );
+
+    std::list<tripoint> submaps_to_delete;
+    int quads_saved = 0;
+    for( const auto &candidate : candidates ) {
+        if( quads_saved >= max_quads || submaps.size() - submaps_to_delete.size() <= target ) {
+            break;
+        }
+        save_quad( candidate.first, submaps_to_delete, true );
+        quads_saved++;
+    }
+    for( const tripoint &addr : submaps_to_delete ) {
+        remove_submap( addr );
+    }
+
+    const int evicted = submaps_to_delete.size();
+    stats.evictions.fetch_add( evicted, std::memory_order_relaxed );
+    return evicted;
+}
+
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
@@ -233,12 +317,12 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
-    if( !submaps.contains( p ) ) {
+    submap *sm = find_submap( p );
+    if( sm == nullptr ) {
         debugmsg( "file did not contain the expected submap %d,%d,%d",
                   p.x, p.y, p.z );
-        return nullptr;
     }
-    return submaps[ p ].get();
+    return sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
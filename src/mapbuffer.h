@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "coordinates.h"
 #include "point.h"
@@ -11,6 +14,18 @@
 class submap;
 class JsonIn;
 
+/** Lookup and eviction counters of a @ref mapbuffer, reset on @ref mapbuffer::clear. */
+struct mapbuffer_stats {
+    /** Lookups answered from memory. */
+    uint64_t hits = 0;
+    /** Lookups of submaps that were not in memory. */
+    uint64_t misses = 0;
+    /** Misses that were satisfied by reading the submap back from the save. */
+    uint64_t loads = 0;
+    /** Submaps written out and dropped to stay within the submap limit. */
+    uint64_t evictions = 0;
+};
+
 /**
  * Store, buffer, save and load the entire world map.
  */
@@ -50,14 +65,41 @@ class mapbuffer
          * @return NULL if the submap is not in the mapbuffer
          * and could not be loaded. The mapbuffer takes care of the returned
          * submap object, don't delete it on your own.
+         * Main thread only, loading a submap modifies the buffer.
          */
         submap *lookup_submap( const tripoint &p );
         submap *lookup_submap( const tripoint_abs_sm &p ) {
             return lookup_submap( p.raw() );
         }
 
+        /** Save and drop quads of submaps that are far from the reality bubble until at most
+         * @p limit submaps remain buffered.
+         *
+         * Quads whose submaps left the reality bubble the longest time ago go first.
+         * Quads within a few overmap terrains of the map are never evicted.
+         * @param map_origin Absolute submap position of the map's origin (@ref map::get_abs_sub).
+         * @param limit Number of submaps to keep, 0 disables eviction.
+         * @param max_quads Upper bound on quads written per call, to spread the work over
+         * several map shifts.
+         * @return Number of submaps evicted.
+         */
+        int evict_cold_submaps( const tripoint &map_origin, size_t limit, int max_quads = 16 );
+
+        size_t size() const {
+            return submaps.size();
+        }
+
+        mapbuffer_stats get_stats() const {
+            return {
+                stats.hits.load( std::memory_order_relaxed ),
+                stats.misses.load( std::memory_order_relaxed ),
+                stats.loads.load( std::memory_order_relaxed ),
+                stats.evictions.load( std::memory_order_relaxed )
+            };
+        }
+
     private:
-        using submap_map_t = std::map<tripoint, std::unique_ptr<submap>>;
+        using submap_map_t = std::unordered_map<tripoint, std::unique_ptr<submap>>;
 
     public:
         submap_map_t::iterator begin() {
@@ -75,11 +117,19 @@ class mapbuffer
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
+        submap *find_submap( const tripoint &p ) const;
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
         void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        /** Counters behind @ref get_stats, so that they can be read from any thread. */
+        struct {
+            std::atomic<uint64_t> hits{ 0 };
+            std::atomic<uint64_t> misses{ 0 };
+            std::atomic<uint64_t> loads{ 0 };
+            std::atomic<uint64_t> evictions{ 0 };
+        } stats;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
@@ -359,6 +360,12 @@ void monster::plan()
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
+    // Without smart planning, `rate_target` rejects anything at least `dist` away,
+    // so only monsters closer than that need to be looked at.
+    const auto search_radius = [&]() {
+        return smart_planning ? INT_MAX : static_cast<int>( std::ceil( dist ) );
+    };
+
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
     if( friendly == 0 && sees( g->u ) && !waiting ) {
         dist = rate_target( g->u, dist, smart_planning );
@@ -389,7 +396,8 @@ void monster::plan()
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
+            for( monster *baby : g->critter_tracker->find_in_radius( g->u.pos(), search_radius() ) ) {
+                monster &tmp = *baby;
                 if( type->baby_monster == tmp.type->id ) {
                     // baby nearby; is the player too close?
                     dist = tmp.rate_target( g->u, dist, smart_planning );
@@ -403,11 +411,11 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
+        for( monster *tmp : g->critter_tracker->find_in_radius( pos(), search_radius() ) ) {
+            if( tmp->friendly == 0 ) {
+                float rating = rate_target( *tmp, dist, smart_planning );
                 if( rating < dist ) {
-                    target = &tmp;
+                    target = tmp;
                     dist = rating;
                 }
             }
@@ -475,12 +483,8 @@ void monster::plan()
                 continue;
             }
 
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
+            for( monster *other : g->critter_tracker->find_in_radius( pos(), search_radius(), fac.first ) ) {
+                monster &mon = *other;
                 float rating = rate_target( mon, dist, smart_planning );
                 if( rating == dist ) {
                     ++valid_targets;
@@ -514,12 +518,9 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
+        for( monster *ally : g->critter_tracker->find_in_radius( pos(), search_radius(),
+                myfaction_iter->first ) ) {
+            monster &mon = *ally;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -1026,6 +1026,7 @@ void mtype::load( const JsonObject &jo, const std::string &src )
         inject_float( "search_cone_angle" );
         inject_float( "max_f_coeff" );
         inject_float( "mob_presence_penalty" );
+        inject_float( "hierarchical_min_dist" );
     }
 
     // blacklisted_specials was originally ported from DDA PRs 75716 and 75804 and thus CC-BY-SA 3.0
@@ -1057,6 +1058,8 @@ void mtype::setup_pathfinding_deferred()
     this->route_settings.max_f_coeff = get_option<float>( "PATHFINDING_MAX_F_COEFF_DEFAULT" );
     this->route_settings.f_limit_based_on_max_dist =
         get_option<bool>( "PATHFINDING_MAX_F_LIMIT_BASED_ON_MAX_DIST" );
+    this->route_settings.hierarchical_min_dist =
+        get_option<float>( "PATHFINDING_HIERARCHICAL_MIN_DIST_DEFAULT" );
 
     const bool default_override = get_option<bool>( "PATHFINDING_DEFAULT_IS_OVERRIDE" );
     const float range_mult = get_option<float>( "PATHFINDING_RANGE_MULT" );
@@ -1154,6 +1157,10 @@ void mtype::setup_pathfinding_deferred()
         extract_into( "search_cone_angle", this->route_settings.search_cone_angle );
         extract_into( "max_f_coeff", this->route_settings.max_f_coeff );
         extract_into( "mob_presence_penalty", this->path_settings.mob_presence_penalty );
+        extract_into( "hierarchical_min_dist", this->route_settings.hierarchical_min_dist );
+    }
+    if( this->route_settings.hierarchical_min_dist < 0 ) {
+        this->route_settings.hierarchical_min_dist = INFINITY;
     }
 
     if( range_mult < 0 ) {
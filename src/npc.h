@@ -17,6 +17,7 @@
 
 #include "auto_pickup.h"
 #include "calendar.h"
+#include "clock_cache.h"
 #include "character.h"
 #include "color.h"
 #include "creature.h"
@@ -29,7 +30,6 @@
 #include "inventory.h"
 #include "item.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "pimpl.h"
 #include "player.h"
 #include "point.h"
@@ -505,7 +505,7 @@ struct npc_short_term_cache {
     std::vector<sphere> dangerous_explosives;
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
-    lru_cache<tripoint, int> searched_tiles;
+    clock_cache<tripoint, int> searched_tiles;
 };
 
 struct npc_need_goal_cache {
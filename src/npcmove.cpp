@@ -4642,5 +4642,9 @@ bool npc::adjust_worn()
 
 void npc::set_movement_mode( character_movemode new_mode )
 {
+    if( move_mode == CMM_CROUCH || new_mode == CMM_CROUCH ) {
+        // crouching affects visibility
+        Creature::invalidate_sight_cache();
+    }
     move_mode = new_mode;
 }
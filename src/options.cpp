@@ -2183,6 +2183,16 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "PREFETCH_DATA_FILES", debug, translate_marker( "Read data files ahead" ),
+         translate_marker( "If true, game data files are read from disk on worker threads while the previous files are being loaded." ),
+         true
+       );
+
+    add( "VERIFIED_DATA_CACHE", debug, translate_marker( "Skip checks of unchanged data" ),
+         translate_marker( "If true, the game remembers when the loaded game data passed its consistency checks without errors, and skips the checks on later loads of exactly the same files.  The data itself is still loaded from JSON every time.  Makes loading faster.  Disable if you're working on JSON data or Lua scripts." ),
+         false
+       );
+
     add_empty_line();
 
     add( "MOD_SOURCE", debug, translate_marker( "Display Mod Source" ),
@@ -2280,6 +2290,31 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "PARALLEL_MAP_CACHE", debug, translate_marker( "Parallel map cache building" ),
+         translate_marker( "If true and the world is in z-level mode, map caches of different z-levels are built at the same time on several threads.  Speeds up turns in areas with many populated z-levels." ),
+         false
+       );
+
+    add( "ASYNC_SAVE", debug, translate_marker( "Background saving" ),
+         translate_marker( "If true, saves in the compressed world format are compressed and written to disk on other threads while the game goes on.  Makes saving and autosaving pause the game for less time.  Experimental: the save is only complete once it has been written in the background, and a crash before then loses it." ),
+         false
+       );
+
+    add( "PREFETCH_SUBMAPS", debug, translate_marker( "Prefetch map in travel direction" ),
+         translate_marker( "If true, saved parts of the map ahead of you are read from disk on other threads before you get there.  Reduces stutter when traveling fast." ),
+         true
+       );
+
+    add( "PREGENERATE_MAP", debug, translate_marker( "Generate map in travel direction" ),
+         translate_marker( "If true, parts of the map ahead of you that were never visited are loaded or generated on the main thread, a few at a time spread over turns, instead of all at once when you step next to them.  Only your current level is covered, and only where the overmap already exists.  Reduces stutter when exploring, but generates places you may never visit, which makes saves larger." ),
+         false
+       );
+
+    add( "MAPBUFFER_SUBMAP_LIMIT", debug, translate_marker( "Map buffer submap limit" ),
+         translate_marker( "If nonzero, submaps far away from you are written to the save and dropped from memory once more than this many are loaded.  Keeps memory use down on long trips, but those areas are stored immediately instead of on the next save.  0 means no limit." ),
+         0, 100000, 0
+       );
+
     add( "ENABLE_EVENTS", debug, translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
@@ -3472,6 +3507,10 @@ void options_manager::cache_to_globals()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    parallel_map_cache = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
+    mapbuffer_submap_limit = ::get_option<int>( "MAPBUFFER_SUBMAP_LIMIT" );
+    prefetch_submaps = ::get_option<bool>( "PREFETCH_SUBMAPS" );
+    pregenerate_map = ::get_option<bool>( "PREGENERATE_MAP" );
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     overmap_transparency = ::get_option<bool>( "OVERMAP_TRANSPARENCY" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
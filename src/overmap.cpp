@@ -2933,20 +2933,65 @@ oter_id overmap::get_default_terrain( int z ) const
     }
 }
 
-void overmap::init_layers()
+map_layer_terrain::map_layer_terrain( const map_layer_terrain &other )
+    : uniform( other.uniform )
+    , tiles( other.tiles ? std::make_unique<grid>( *other.tiles ) : nullptr )
 {
-    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
+}
 
-        for( int i = 0; i < OMAPX; ++i ) {
-            for( int j = 0; j < OMAPY; ++j ) {
-                layer[k].terrain[i][j] = tid;
-                layer[k].visible[i][j] = false;
-                layer[k].explored[i][j] = false;
-                layer[k].path[i][j] = false;
+map_layer_terrain &map_layer_terrain::operator=( const map_layer_terrain &other )
+{
+    if( this != &other ) {
+        uniform = other.uniform;
+        tiles = other.tiles ? std::make_unique<grid>( *other.tiles ) : nullptr;
+    }
+    return *this;
+}
+
+void map_layer_terrain::fill( const oter_id &id )
+{
+    uniform = id;
+    tiles.reset();
+}
+
+void map_layer_terrain::set( const point_om_omt &p, const oter_id &id )
+{
+    if( !tiles ) {
+        if( id == uniform ) {
+            return;
+        }
+        tiles = std::make_unique<grid>();
+        for( auto &column : *tiles ) {
+            column.fill( uniform );
+        }
+    }
+    ( *tiles )[p.x()][p.y()] = id;
+}
+
+void map_layer_terrain::compact()
+{
+    if( !tiles ) {
+        return;
+    }
+    const oter_id first = ( *tiles )[0][0];
+    for( const auto &column : *tiles ) {
+        for( const oter_id &id : column ) {
+            if( id != first ) {
+                return;
             }
         }
     }
+    fill( first );
+}
+
+void overmap::init_layers()
+{
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        layer[k].terrain.fill( get_default_terrain( k - OVERMAP_DEPTH ) );
+        layer[k].visible.reset();
+        layer[k].explored.reset();
+        layer[k].path.reset();
+    }
 }
 
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
@@ -2956,7 +3001,7 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    layer[p.z() + OVERMAP_DEPTH].terrain.set( p.xy(), id );
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -2966,7 +3011,7 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
         return ot_null;
     }
 
-    return layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].terrain.get( p.xy() );
 }
 
 std::string *overmap::join_used_at( const om_pos_dir &p )
@@ -2987,30 +3032,20 @@ std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p
     return &mapgen_arg_storage[it->second];
 }
 
-bool &overmap::seen( const tripoint_om_omt &p )
-{
-    if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
-    }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
-}
-
 bool overmap::seen( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].visible[map_layer::flag_index( p.xy() )];
 }
 
-bool &overmap::explored( const tripoint_om_omt &p )
+void overmap::set_seen( const tripoint_om_omt &p, bool value )
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
+    layer[p.z() + OVERMAP_DEPTH].visible[map_layer::flag_index( p.xy() )] = value;
 }
 
 bool overmap::is_explored( const tripoint_om_omt &p ) const
@@ -3018,16 +3053,15 @@ bool overmap::is_explored( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].explored[map_layer::flag_index( p.xy() )];
 }
 
-bool &overmap::path( const tripoint_om_omt &p )
+void overmap::set_explored( const tripoint_om_omt &p, bool value )
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    layer[p.z() + OVERMAP_DEPTH].explored[map_layer::flag_index( p.xy() )] = value;
 }
 
 bool overmap::is_path( const tripoint_om_omt &p ) const
@@ -3035,7 +3069,15 @@ bool overmap::is_path( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].path[map_layer::flag_index( p.xy() )];
+}
+
+void overmap::set_path( const tripoint_om_omt &p, bool value )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    layer[p.z() + OVERMAP_DEPTH].path[map_layer::flag_index( p.xy() )] = value;
 }
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
@@ -6188,6 +6230,10 @@ void overmap::open( overmap_special_batch &enabled_specials )
         // pointers looks like (north, south, west, east)
         generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
     }
+
+    for( map_layer &l : layer ) {
+        l.terrain.compact();
+    }
 }
 
 // Note: this may throw io errors from std::ofstream
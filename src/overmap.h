@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <climits>
 #include <cstdlib>
 #include <functional>
@@ -106,13 +107,52 @@ struct radio_tower {
                  radio_type T = radio_type::MESSAGE_BROADCAST );
 };
 
+/**
+ * Terrain of a single overmap z-level.
+ * Most layers far above or below ground never hold anything but their default
+ * terrain, so the per-tile grid is only allocated once a different id is written.
+ */
+class map_layer_terrain
+{
+    public:
+        map_layer_terrain() = default;
+        map_layer_terrain( const map_layer_terrain &other );
+        map_layer_terrain( map_layer_terrain && ) noexcept = default;
+        map_layer_terrain &operator=( const map_layer_terrain &other );
+        map_layer_terrain &operator=( map_layer_terrain && ) noexcept = default;
+
+        /** Sets every tile of the layer to `id`, releasing the per-tile grid. */
+        void fill( const oter_id &id );
+        const oter_id &get( const point_om_omt &p ) const {
+            return tiles ? ( *tiles )[p.x()][p.y()] : uniform;
+        }
+        void set( const point_om_omt &p, const oter_id &id );
+        /** Releases the per-tile grid if every tile holds the same terrain. */
+        void compact();
+        /** @returns the id held by every tile, or nullptr if the layer is not uniform. */
+        const oter_id *uniform_id() const {
+            return tiles ? nullptr : &uniform;
+        }
+    private:
+        using grid = std::array<std::array<oter_id, OMAPY>, OMAPX>;
+        oter_id uniform;
+        std::unique_ptr<grid> tiles;
+};
+
 struct map_layer {
-    oter_id terrain[OMAPX][OMAPY];
-    bool visible[OMAPX][OMAPY];
-    bool explored[OMAPX][OMAPY];
-    bool path[OMAPX][OMAPY];
+    using flag_set = std::bitset<OMAPX * OMAPY>;
+
+    map_layer_terrain terrain;
+    flag_set visible;
+    flag_set explored;
+    flag_set path;
     std::vector<om_note> notes;
     std::vector<om_map_extra> extras;
+
+    /** Index of a tile in the flag sets, row by row as they are saved. */
+    static size_t flag_index( const point_om_omt &p ) {
+        return static_cast<size_t>( p.y() ) * OMAPX + p.x();
+    }
 };
 
 static const std::map<std::string, oter_flags> oter_flags_map = {
@@ -234,12 +274,12 @@ class overmap
         const oter_id &ter( const tripoint_om_omt &p ) const;
         std::string *join_used_at( const om_pos_dir & );
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_om_omt & );
-        bool &seen( const tripoint_om_omt &p );
         bool seen( const tripoint_om_omt &p ) const;
-        bool &explored( const tripoint_om_omt &p );
+        void set_seen( const tripoint_om_omt &p, bool value );
         bool is_explored( const tripoint_om_omt &p ) const;
-        bool &path( const tripoint_om_omt &p );
+        void set_explored( const tripoint_om_omt &p, bool value );
         bool is_path( const tripoint_om_omt &p ) const;
+        void set_path( const tripoint_om_omt &p, bool value );
 
         bool has_note( const tripoint_om_omt &p ) const;
         std::optional<int> has_note_with_danger_radius( const tripoint_om_omt &p ) const;
@@ -356,7 +396,6 @@ class overmap
 
         std::vector<shared_ptr_fast<npc>> npcs;
 
-        bool nullbool = false;
         point_abs_om loc;
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
@@ -46,6 +46,7 @@
 #include "vehicle.h"
 #include "vehicle_part.h"
 #include "profile.h"
+#include "thread_pool.h"
 #include "world.h"
 
 class map_extra;
@@ -121,20 +122,22 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
 {
     using overmap_loc = std::pair<point_abs_om, std::unique_ptr<overmap>>;
 
+    cata::thread_pool &pool = cata::get_thread_pool();
     std::vector<std::future<overmap_loc>> async_data;
-    for( auto &loc : locs ) {
+    for( const point_abs_om &loc : locs ) {
         if( overmap_buffer.has( loc ) ) {
             continue;
         }
 
-        auto gen_func = [&]() {
+        auto gen_func = [this, loc]() {
             auto map = std::make_unique<overmap>( loc );
             map->populate();
             fix_mongroups( *map );
             fix_npcs( *map );
             return std::make_pair( loc, std::move( map ) );
         };
-        async_data.push_back( std::async( std::launch::async, gen_func ) );
+        async_data.push_back( pool.submit( gen_func, cata::task_priority::normal,
+                                           "overmap_generate" ) );
     }
 
     auto popup = make_shared_fast<throbber_popup>( _( "Please wait..." ) );
@@ -445,7 +448,7 @@ bool overmapbuffer::is_explored( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_explored( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->explored( om_loc.local ) = !om_loc.om->explored( om_loc.local );
+    om_loc.om->set_explored( om_loc.local, !om_loc.om->is_explored( om_loc.local ) );
 }
 
 bool overmapbuffer::is_path( const tripoint_abs_omt &p )
@@ -459,7 +462,7 @@ bool overmapbuffer::is_path( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_path( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->path( om_loc.local ) = !om_loc.om->path( om_loc.local );
+    om_loc.om->set_path( om_loc.local, !om_loc.om->is_path( om_loc.local ) );
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -688,7 +691,7 @@ bool overmapbuffer::seen( const tripoint_abs_omt &p )
 void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->seen( om_loc.local ) = seen;
+    om_loc.om->set_seen( om_loc.local, seen );
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -1035,7 +1038,7 @@ bool overmapbuffer::is_findable_location( const overmap_with_local_coords &om_lo
         return false;
     }
 
-    const auto is_explored = om_loc.om->explored( om_loc.local );
+    const auto is_explored = om_loc.om->is_explored( om_loc.local );
     if( params.explored.has_value() && params.explored.value() != is_explored ) {
         return false;
     }
@@ -1142,8 +1145,7 @@ struct find_task_generator {
 std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
-    const auto concurrency = std::max( 1u, std::thread::hardware_concurrency() - 1 );
-    if( concurrency == 1 ) {
+    if( cata::get_thread_pool().num_workers() <= 1 ) {
         return find_all_sync( origin, params );
     } else {
         return find_all_async( origin, params );
@@ -1222,47 +1224,75 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
 
     find_task_generator gen( origin.raw().xy(), min_dist, max_dist, min_layer, max_layer, 256 );
 
+    cata::thread_pool &pool = cata::get_thread_pool();
+    cata::cancellation_token cancel_remaining;
     std::deque<std::future<std::vector<tripoint_abs_omt>>> tasks;
 
     std::vector<tripoint_abs_omt> find_result;
-    int free_tasks = std::max( 1u, std::thread::hardware_concurrency() - 1 );
-    auto try_finish_task = []( std::future<std::vector<tripoint_abs_omt>> &task,
-    std::vector<tripoint_abs_omt> &dst, omt_find_params params ) -> bool {
-        if( task.wait_for( std::chrono::milliseconds( 0 ) ) == std::future_status::ready )
-        {
-            auto task_result = task.get();
-
-            if( !params.max_results.has_value() ||
-                dst.size() < static_cast<size_t>( params.max_results.value() ) ) {
-                std::ranges::copy( task_result, std::back_inserter( dst ) );
-                if( params.max_results.has_value() &&
-                    dst.size() > static_cast<uint64_t>( params.max_results.value() ) ) {
-                    dst.resize( params.max_results.value() );
-                }
+    const bool has_max = params.max_results.has_value();
+    const size_t max_results = static_cast<size_t>( params.max_results.value_or( 0 ) );
+    auto finish_task = [&]( std::future<std::vector<tripoint_abs_omt>> &task ) {
+        std::vector<tripoint_abs_omt> task_result;
+        try {
+            task_result = task.get();
+        } catch( const cata::task_cancelled & ) {
+            return;
+        }
+        if( !has_max || find_result.size() < max_results ) {
+            std::ranges::copy( task_result, std::back_inserter( find_result ) );
+            if( has_max && find_result.size() > max_results ) {
+                find_result.resize( max_results );
             }
-
-            return true;
         }
-        return false;
+    };
+    // Blocks on the oldest task, keeping the popup alive, and merges its result.
+    auto finish_front_task = [&]() {
+        while( tasks.front().wait_for( std::chrono::milliseconds( 10 ) ) != std::future_status::ready ) {
+            if( params.popup ) {
+                params.popup->refresh();
+            }
+        }
+        finish_task( tasks.front() );
+        tasks.pop_front();
     };
 
-    while( true ) {
-        if( params.popup ) {
-            params.popup->refresh();
+    auto task_func = [&]( point_abs_om l,
+    std::vector<std::pair<tripoint_abs_omt, tripoint_om_omt>> locals ) {
+        std::vector<tripoint_abs_omt> result;
+
+        overmap *om_loc;
+        if( params.existing_only ) {
+            om_loc = get_existing( l );
+        } else {
+            om_loc = &get( l );
+        }
+        if( !om_loc ) {
+            return result;
         }
 
-        if( !tasks.empty() ) {
-            if( try_finish_task( tasks.front(), find_result, params ) ) {
-                tasks.pop_front();
-                ++free_tasks;
+        for( const auto &loc : locals ) {
+            overmap_with_local_coords q{ om_loc, loc.second };
+            if( is_findable_location( q, params ) ) {
+                result.push_back( loc.first );
             }
-            if( params.max_results.has_value() &&
-                find_result.size() >= static_cast<uint64_t>( params.max_results.value() ) ) {
+            if( has_max && result.size() == max_results ) {
                 break;
             }
         }
 
-        if( free_tasks == 0 ) {
+        return result;
+    };
+
+    // Keep only as many tasks in flight as there are workers, results are
+    // merged in generation order so the closest locations come first.
+    const size_t max_in_flight = pool.num_workers();
+    while( !has_max || find_result.size() < max_results ) {
+        if( params.popup ) {
+            params.popup->refresh();
+        }
+
+        if( tasks.size() >= max_in_flight ) {
+            finish_front_task();
             continue;
         }
 
@@ -1277,50 +1307,18 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             continue;
         }
 
-        auto task_func = [&]( point_abs_om l,
-        std::vector<std::pair<tripoint_abs_omt, tripoint_om_omt>> locals ) {
-            std::vector<tripoint_abs_omt> result;
-
-            overmap *om_loc;
-            if( params.existing_only ) {
-                om_loc = get_existing( l );
-            } else {
-                om_loc = &get( l );
-            }
-            if( !om_loc ) {
-                return result;
-            }
-
-            for( const auto &loc : locals ) {
-                overmap_with_local_coords q{ om_loc, loc.second };
-                if( is_findable_location( q, params ) ) {
-                    result.push_back( loc.first );
-                }
-                if( params.max_results.has_value() &&
-                    result.size() == static_cast<uint64_t>( params.max_results.value() ) ) {
-                    break;
-                }
-            }
-
-            return result;
-        };
-
-        auto task = std::async( std::launch::async, task_func, task_om, std::move( task_omts ) );
-
-        tasks.push_back( std::move( task ) );
-
-        --free_tasks;
+        tasks.push_back( pool.submit(
+                             [&task_func, task_om, locals = std::move( task_omts )]() mutable {
+            return task_func( task_om, std::move( locals ) );
+        }, cata::task_priority::normal, "overmap_find_all", cancel_remaining ) );
     }
 
+    // Anything still queued can't contribute once we have enough results.
+    if( has_max && find_result.size() >= max_results ) {
+        cancel_remaining.cancel();
+    }
     while( !tasks.empty() ) {
-        if( params.popup ) {
-            params.popup->refresh();
-        }
-
-        if( try_finish_task( tasks.front(), find_result, params ) ) {
-            tasks.pop_front();
-            ++free_tasks;
-        }
+        finish_front_task();
     }
 
     return find_result;
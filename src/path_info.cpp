@@ -157,6 +157,10 @@ std::string PATH_INFO::datadir()
 {
     return datadir_value;
 }
+std::string PATH_INFO::data_verification()
+{
+    return config_dir_value + "verified_data.json";
+}
 std::string PATH_INFO::debug()
 {
     return config_dir_value + "debug.log";
@@ -18,6 +18,7 @@ std::string color_templates();
 std::string config_dir();
 std::string custom_colors();
 std::string datadir();
+std::string data_verification();
 std::string debug();
 std::string defaultsounddir();
 std::string defaulttilejson();
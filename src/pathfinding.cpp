@@ -6,10 +6,13 @@
 #include <queue>
 #include <vector>
 
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
 #include "game.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "point.h"
+#include "profile.h"
 #include "submap.h"
 #include "trap.h"
 #include "veh_type.h"
@@ -34,6 +37,11 @@ decltype( Pathfinding::z_area ) Pathfinding::z_area = {};
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
 decltype( Pathfinding::cached_closest_z_changes ) Pathfinding::cached_closest_z_changes = {};
+decltype( Pathfinding::clusters ) Pathfinding::clusters = {};
+decltype( Pathfinding::cluster_area ) Pathfinding::cluster_area = {};
+decltype( Pathfinding::stats ) Pathfinding::stats = {};
+decltype( Pathfinding::stats_at_turn_start ) Pathfinding::stats_at_turn_start = {};
+decltype( Pathfinding::last_turn_stats ) Pathfinding::last_turn_stats = {};
 
 // Thanks for nothing, MVSC
 // For our MVSC builds, std::is_nan and std::is_inf are not constexpr
@@ -47,6 +55,21 @@ static constexpr bool is_inf( float x )
     return x == INFINITY;
 }
 
+// pathfinding_stats impls
+pathfinding_stats pathfinding_stats::operator-( const pathfinding_stats &rhs ) const
+{
+    pathfinding_stats result;
+    result.routes = routes - rhs.routes;
+    result.route_time = route_time - rhs.route_time;
+    result.d_maps_built = d_maps_built - rhs.d_maps_built;
+    result.d_maps_reused = d_maps_reused - rhs.d_maps_reused;
+    result.d_maps_rebuilt = d_maps_rebuilt - rhs.d_maps_rebuilt;
+    result.d_maps_invalidated = d_maps_invalidated - rhs.d_maps_invalidated;
+    result.tiles_expanded = tiles_expanded - rhs.tiles_expanded;
+    result.abstract_routes = abstract_routes - rhs.abstract_routes;
+    result.clusters_built = clusters_built - rhs.clusters_built;
+    return result;
+}
 // PathfindingSettings impls
 int PathfindingSettings::z_move_type() const
 {
@@ -199,6 +222,17 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 }
 void Pathfinding::clear_d_maps()
 {
+    Pathfinding::stats.d_maps_invalidated += Pathfinding::d_maps.size();
+    Pathfinding::last_turn_stats = Pathfinding::stats - Pathfinding::stats_at_turn_start;
+    Pathfinding::stats_at_turn_start = Pathfinding::stats;
+
+    TracyPlot( "Pathfinding routes", static_cast<int64_t>( last_turn_stats.routes ) );
+    TracyPlot( "Pathfinding d_maps built", static_cast<int64_t>( last_turn_stats.d_maps_built ) );
+    TracyPlot( "Pathfinding d_maps reused", static_cast<int64_t>( last_turn_stats.d_maps_reused ) );
+    TracyPlot( "Pathfinding d_maps rebuilt", static_cast<int64_t>( last_turn_stats.d_maps_rebuilt ) );
+    TracyPlot( "Pathfinding tiles expanded", static_cast<int64_t>( last_turn_stats.tiles_expanded ) );
+    TracyPlot( "Pathfinding clusters built", static_cast<int64_t>( last_turn_stats.clusters_built ) );
+
     for( auto &map : Pathfinding::d_maps ) {
         map->reset_maps();
         map->reset_tile_state();
@@ -211,6 +245,12 @@ void Pathfinding::clear_d_maps()
     Pathfinding::d_maps.clear();
     Pathfinding::cached_closest_z_changes.clear();
 }
+void Pathfinding::reset_stats()
+{
+    Pathfinding::stats = pathfinding_stats();
+    Pathfinding::stats_at_turn_start = pathfinding_stats();
+    Pathfinding::last_turn_stats = pathfinding_stats();
+}
 void Pathfinding::reset_maps()
 {
     this->p_at( this->dest ) = 0.0;
@@ -417,6 +457,162 @@ void Pathfinding::update_z_caches( bool update_open_air )
 
     Pathfinding::z_area = cur_z_area;
 }
+/// Pathfinding: submap clusters
+// Cost of stepping onto local `p` in the coarse graph. Doors count as passable if the route
+//   can open them, anything else that needs special abilities does not.
+static float cluster_tile_cost( const map &here, const tripoint &p, bool can_open_doors )
+{
+    const int move_cost = here.move_cost_ter_furn( p );
+    if( move_cost > 0 ) {
+        return move_cost;
+    }
+    const maptile &tile = here.maptile_at( p );
+    if( can_open_doors && ( tile.get_ter_t().open || tile.get_furn_t().open ) ) {
+        // Open, then step in
+        return 4.0;
+    }
+    return INFINITY;
+}
+
+using cluster_tiles = std::array<float, SEEX * SEEY>;
+
+// Cheapest costs of reaching each tile of a submap from `start` without leaving the submap,
+//   given the cost of stepping onto each of its tiles
+static cluster_tiles cluster_costs_from( const cluster_tiles &tile_costs, const point &start )
+{
+    using Frontier = std::priority_queue<std::pair<float, int>, std::vector<std::pair<float, int>>, pair_greater_cmp_first>;
+
+    cluster_tiles costs;
+    costs.fill( INFINITY );
+    Frontier frontier;
+    costs[start.x + start.y * SEEX] = 0.0;
+    frontier.emplace( 0.0, start.x + start.y * SEEX );
+
+    while( !frontier.empty() ) {
+        const auto [cost, idx] = frontier.top();
+        frontier.pop();
+        if( cost > costs[idx] ) {
+            continue;
+        }
+        const point cur( idx % SEEX, idx / SEEX );
+        for( const point &dir : DIRS_2D ) {
+            const point next = cur + dir;
+            if( next.x < 0 || next.y < 0 || next.x >= SEEX || next.y >= SEEY ) {
+                continue;
+            }
+            const int next_idx = next.x + next.y * SEEX;
+            const bool is_diag = dir.x != 0 && dir.y != 0;
+            const float next_cost = cost + tile_costs[next_idx] * ( is_diag ? 0.75 : 0.5 );
+            if( next_cost < costs[next_idx] ) {
+                costs[next_idx] = next_cost;
+                frontier.emplace( next_cost, next_idx );
+            }
+        }
+    }
+    return costs;
+}
+
+const Pathfinding::Cluster *Pathfinding::get_cluster( const tripoint &abs_sm, bool can_open_doors )
+{
+    std::unordered_map<tripoint, Cluster> &clusters = Pathfinding::clusters[can_open_doors];
+    auto it = clusters.find( abs_sm );
+    if( it != clusters.end() ) {
+        return &it->second;
+    }
+
+    const map &here = get_map();
+    const tripoint origin = here.getlocal( sm_to_ms_copy( abs_sm ) );
+    if( !here.inbounds( origin ) ) {
+        return nullptr;
+    }
+
+    cluster_tiles tile_costs;
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            tile_costs[x + y * SEEX] = cluster_tile_cost( here, origin + point( x, y ), can_open_doors );
+        }
+    }
+
+    Cluster cluster;
+    // Each side as the first inner tile, direction along the edge and direction out of the submap
+    const std::array<std::array<point, 3>, 4> sides = {{
+            { point_zero, point_east, point_north },
+            { point( 0, SEEY - 1 ), point_east, point_south },
+            { point_zero, point_south, point_west },
+            { point( SEEX - 1, 0 ), point_south, point_east },
+        }
+    };
+    for( const auto &[first, along, out] : sides ) {
+        // Start of the current run of tiles walkable on both sides of the border
+        int run_start = -1;
+        for( int i = 0; i <= SEEX; i++ ) {
+            const point inner = first + along * i;
+            const tripoint outer = origin + inner + out;
+            const bool walkable = i < SEEX && here.inbounds( outer ) &&
+                                  !is_inf( tile_costs[inner.x + inner.y * SEEX] ) &&
+                                  !is_inf( cluster_tile_cost( here, outer, can_open_doors ) );
+            if( walkable && run_start < 0 ) {
+                run_start = i;
+            } else if( !walkable && run_start >= 0 ) {
+                const point mid = first + along * ( ( run_start + i - 1 ) / 2 );
+                cluster.entrances.push_back( here.getabs( origin + mid ) );
+                cluster.exits.push_back( here.getabs( origin + mid + out ) );
+                cluster.exit_costs.push_back( 0.5 * cluster_tile_cost( here, origin + mid + out,
+                                              can_open_doors ) );
+                run_start = -1;
+            }
+        }
+    }
+
+    const size_t n = cluster.entrances.size();
+    const tripoint abs_origin = sm_to_ms_copy( abs_sm );
+    cluster.paths.resize( n * n );
+    for( size_t i = 0; i < n; i++ ) {
+        const cluster_tiles costs = cluster_costs_from( tile_costs,
+                                    ( cluster.entrances[i] - abs_origin ).xy() );
+        for( size_t j = 0; j < n; j++ ) {
+            const point p = ( cluster.entrances[j] - abs_origin ).xy();
+            cluster.paths[i * n + j] = costs[p.x + p.y * SEEX];
+        }
+    }
+
+    Pathfinding::stats.clusters_built++;
+    return &clusters.emplace( abs_sm, std::move( cluster ) ).first->second;
+}
+void Pathfinding::mark_dirty_cluster( const tripoint &p )
+{
+    const tripoint abs_sm = ms_to_sm_copy( p );
+    const point in_sm = p.xy() - sm_to_ms_copy( abs_sm.xy() );
+    for( std::unordered_map<tripoint, Cluster> &clusters : Pathfinding::clusters ) {
+        if( clusters.empty() ) {
+            continue;
+        }
+        clusters.erase( abs_sm );
+        // Edge tiles are also part of the entrances of the neighbouring submaps
+        if( in_sm.x == 0 ) {
+            clusters.erase( abs_sm + point_west );
+        } else if( in_sm.x == SEEX - 1 ) {
+            clusters.erase( abs_sm + point_east );
+        }
+        if( in_sm.y == 0 ) {
+            clusters.erase( abs_sm + point_north );
+        } else if( in_sm.y == SEEY - 1 ) {
+            clusters.erase( abs_sm + point_south );
+        }
+    }
+}
+void Pathfinding::mark_dirty_submap( const tripoint &abs_sm )
+{
+    for( std::unordered_map<tripoint, Cluster> &clusters : Pathfinding::clusters ) {
+        if( clusters.empty() ) {
+            continue;
+        }
+        clusters.erase( abs_sm );
+        for( const point &dir : four_adjacent_offsets ) {
+            clusters.erase( abs_sm + dir );
+        }
+    }
+}
 /// Pathfinding: main loops
 void Pathfinding::detect_culled_frontier(
     const point &start, const RouteSettings &route_settings, std::unordered_set<point> &out )
@@ -507,6 +703,9 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                 return ExpansionOutcome::NO_PATH_EXISTS;
         }
     } else {
+        if( !this->tile_state_modify_set.empty() ) {
+            Pathfinding::stats.d_maps_rebuilt++;
+        }
         // Only reset tile state, we will reuse already calculated g-values
         this->reset_tile_state();
 
@@ -545,6 +744,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         const point next_point = biased_frontier.top().second;
 
         biased_frontier.pop();
+        Pathfinding::stats.tiles_expanded++;
 
         if( !unculled_area.empty() && !unculled_area.contains( next_point ) ) {
             culled_frontier.insert( next_point );
@@ -811,8 +1011,10 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     if( d_map_it == Pathfinding::d_maps.end() ) {
         Pathfinding::produce_d_map( to, z, path_settings );
         d_map = Pathfinding::d_maps.back().get();
+        Pathfinding::stats.d_maps_built++;
     } else {
         d_map = d_map_it->get();
+        Pathfinding::stats.d_maps_reused++;
     }
 
     if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
@@ -891,6 +1093,160 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     return result;
 }
 
+std::vector<tripoint> Pathfinding::get_route_hierarchical(
+    const point from, const point to, const int z,
+    const PathfindingSettings &path_settings,
+    const RouteSettings &route_settings )
+{
+    ZoneScoped;
+
+    const map &here = get_map();
+
+    // Submaps that left the map may change without us noticing
+    if( here.get_abs_sub() != Pathfinding::cluster_area ) {
+        const point min_sm = here.get_abs_sub().xy();
+        const point max_sm = min_sm + point( here.getmapsize(), here.getmapsize() );
+        for( std::unordered_map<tripoint, Cluster> &clusters : Pathfinding::clusters ) {
+            std::erase_if( clusters, [&min_sm, &max_sm]( const auto & pair ) {
+                const tripoint &sm = pair.first;
+                return sm.x < min_sm.x || sm.y < min_sm.y || sm.x >= max_sm.x || sm.y >= max_sm.y;
+            } );
+        }
+        Pathfinding::cluster_area = here.get_abs_sub();
+    }
+
+    const tripoint abs_from = here.getabs( tripoint( from, z ) );
+    const tripoint abs_to = here.getabs( tripoint( to, z ) );
+    const tripoint from_sm = ms_to_sm_copy( abs_from );
+    const tripoint to_sm = ms_to_sm_copy( abs_to );
+    if( from_sm == to_sm ) {
+        return std::vector<tripoint>();
+    }
+
+    const bool can_open_doors = !is_inf( path_settings.door_open_cost );
+    const Cluster *from_cluster = Pathfinding::get_cluster( from_sm, can_open_doors );
+    const Cluster *to_cluster = Pathfinding::get_cluster( to_sm, can_open_doors );
+    if( from_cluster == nullptr || to_cluster == nullptr ) {
+        return std::vector<tripoint>();
+    }
+
+    Pathfinding::stats.abstract_routes++;
+
+    // Costs from `from` to the entrances of its submap and from the entrances of the last submap to `to`
+    const auto costs_to_entrances = [&here, can_open_doors]( const Cluster & cluster,
+    const tripoint & abs_sm,
+    const tripoint & abs_p ) {
+        const tripoint origin = here.getlocal( sm_to_ms_copy( abs_sm ) );
+        cluster_tiles tile_costs;
+        for( int y = 0; y < SEEY; y++ ) {
+            for( int x = 0; x < SEEX; x++ ) {
+                tile_costs[x + y * SEEX] = cluster_tile_cost( here, origin + point( x, y ), can_open_doors );
+            }
+        }
+        const cluster_tiles costs = cluster_costs_from( tile_costs,
+                                    ( abs_p - sm_to_ms_copy( abs_sm ) ).xy() );
+        std::vector<float> result;
+        for( const tripoint &entrance : cluster.entrances ) {
+            const point p = ( entrance - sm_to_ms_copy( abs_sm ) ).xy();
+            result.push_back( costs[p.x + p.y * SEEX] );
+        }
+        return result;
+    };
+    const std::vector<float> from_costs = costs_to_entrances( *from_cluster, from_sm, abs_from );
+    const std::vector<float> to_costs = costs_to_entrances( *to_cluster, to_sm, abs_to );
+
+    // A* over entrances, where moving a tile costs at least 1.0 straight and 1.5 diagonally
+    using Frontier = std::priority_queue<std::pair<float, tripoint>, std::vector<std::pair<float, tripoint>>, pair_greater_cmp_first>;
+    Frontier frontier;
+    std::unordered_map<tripoint, float> g_values;
+    std::unordered_map<tripoint, tripoint> came_from;
+    const auto relax = [&]( const tripoint & p, float g_value, const tripoint & parent ) {
+        if( is_inf( g_value ) ) {
+            return;
+        }
+        auto it = g_values.find( p );
+        if( it != g_values.end() && it->second <= g_value ) {
+            return;
+        }
+        g_values.insert_or_assign( p, g_value );
+        came_from.insert_or_assign( p, parent );
+        const int dx = std::abs( p.x - abs_to.x );
+        const int dy = std::abs( p.y - abs_to.y );
+        frontier.emplace( g_value + std::max( dx, dy ) + 0.5 * std::min( dx, dy ), p );
+    };
+
+    for( size_t i = 0; i < from_cluster->entrances.size(); i++ ) {
+        relax( from_cluster->entrances[i], from_costs[i], abs_from );
+    }
+
+    bool found = false;
+    std::unordered_set<tripoint> closed;
+    while( !frontier.empty() ) {
+        const tripoint cur = frontier.top().second;
+        frontier.pop();
+        if( cur == abs_to ) {
+            found = true;
+            break;
+        }
+        if( !closed.insert( cur ).second ) {
+            continue;
+        }
+        const float cur_g = g_values.at( cur );
+        const tripoint cur_sm = ms_to_sm_copy( cur );
+        const Cluster *cluster = Pathfinding::get_cluster( cur_sm, can_open_doors );
+        if( cluster == nullptr ) {
+            continue;
+        }
+        const size_t n = cluster->entrances.size();
+        for( size_t i = 0; i < n; i++ ) {
+            if( cluster->entrances[i] != cur ) {
+                continue;
+            }
+            relax( cluster->exits[i], cur_g + cluster->exit_costs[i], cur );
+            for( size_t j = 0; j < n; j++ ) {
+                relax( cluster->entrances[j], cur_g + cluster->paths[i * n + j], cur );
+            }
+            if( cur_sm == to_sm ) {
+                relax( abs_to, cur_g + to_costs[i], cur );
+            }
+        }
+    }
+    if( !found ) {
+        return std::vector<tripoint>();
+    }
+
+    // Refine towards the first tile of each submap on the way
+    std::vector<tripoint> waypoints;
+    for( tripoint p = abs_to; p != abs_from; p = came_from.at( p ) ) {
+        const tripoint &parent = came_from.at( p );
+        if( p == abs_to || ms_to_sm_copy( parent ) != ms_to_sm_copy( p ) ) {
+            waypoints.push_back( p );
+        }
+    }
+
+    std::vector<tripoint> result;
+    point cur = from;
+    for( auto it = waypoints.rbegin(); it != waypoints.rend(); ++it ) {
+        const point next = here.getlocal( *it ).xy();
+        const std::vector<tripoint> segment = Pathfinding::get_route_2d( cur, next, z, path_settings,
+                                              route_settings );
+        if( segment.empty() ) {
+            return std::vector<tripoint>();
+        }
+        // Segments share their ends
+        result.insert( result.end(), result.empty() ? segment.begin() : segment.begin() + 1,
+                       segment.end() );
+        cur = next;
+    }
+
+    const int chebyshev_distance = square_dist_fast( tripoint( from, z ), tripoint( to, z ) );
+    // The route includes both ends, which are not steps
+    if( static_cast<float>( result.size() ) > route_settings.max_s_coeff * chebyshev_distance + 2 ) {
+        return std::vector<tripoint>();
+    }
+    return result;
+}
+
 std::vector<tripoint> Pathfinding::get_route_3d(
     const tripoint from, const tripoint to,
     const PathfindingSettings path_settings,
@@ -1073,6 +1429,14 @@ std::vector<tripoint> Pathfinding::route(
     const std::optional<PathfindingSettings> maybe_path_settings,
     const std::optional<RouteSettings> maybe_route_settings )
 {
+    ZoneScoped;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    Pathfinding::stats.routes++;
+    on_out_of_scope add_route_time( [&start_time]() {
+        Pathfinding::stats.route_time += std::chrono::steady_clock::now() - start_time;
+    } );
+
     const map &here = get_map();
 
     here.clip_to_bounds( from );
@@ -1088,6 +1452,13 @@ std::vector<tripoint> Pathfinding::route(
     }
 
     if( from.z == to.z ) {
+        if( rl_dist_exact( from, to ) >= route_settings.hierarchical_min_dist ) {
+            std::vector<tripoint> result = Pathfinding::get_route_hierarchical( from.xy(), to.xy(), from.z,
+                                           path_settings, route_settings );
+            if( !result.empty() ) {
+                return result;
+            }
+        }
         return Pathfinding::get_route_2d( from.xy(), to.xy(), from.z,
                                           path_settings, route_settings );
     }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -169,6 +171,38 @@ struct RouteSettings {
 
     // Does the search domain depend on start position?
     constexpr bool is_relative_search_domain() const;
+
+    /* Routes between points at least this far apart are first planned over a coarse graph of submap borders
+      and then refined one submap at a time, instead of expanding a single dijikstra map over the whole distance.
+    The coarse graph only knows about terrain and furniture: if it needs bashing, vehicles or ledges, or refining
+      any part of it fails, the route is searched for the usual way.
+    INFINITY disables the coarse planning.
+    */
+    float hierarchical_min_dist = INFINITY;
+};
+
+// Counters of the dijikstra map cache, for profiling and the debug menu
+struct pathfinding_stats {
+    // Calls to `Pathfinding::route`
+    uint64_t routes = 0;
+    // Time spent inside `Pathfinding::route`
+    std::chrono::nanoseconds route_time = std::chrono::nanoseconds::zero();
+    // d_maps created because no cached one had the same destination, z-level and settings
+    uint64_t d_maps_built = 0;
+    // d_maps taken from the cache
+    uint64_t d_maps_reused = 0;
+    // Cached d_maps whose tile states had to be recomputed because of a relative search domain
+    uint64_t d_maps_rebuilt = 0;
+    // d_maps thrown away at the end of a turn
+    uint64_t d_maps_invalidated = 0;
+    // Tiles taken from the frontier and expanded to their neighbours
+    uint64_t tiles_expanded = 0;
+    // Routes planned over submap clusters first, see `RouteSettings::hierarchical_min_dist`
+    uint64_t abstract_routes = 0;
+    // Submap clusters whose entrances and inner paths were computed
+    uint64_t clusters_built = 0;
+
+    pathfinding_stats operator-( const pathfinding_stats &rhs ) const;
 };
 
 class Pathfinding
@@ -212,6 +246,20 @@ class Pathfinding
             std::optional<ZLevelChange> reach_from_above;
         };
 
+        // A submap as a node of the coarse graph used for long routes.
+        // All points are in absolute map square coordinates.
+        struct Cluster {
+            // Tiles on the submap edge, one for each run of walkable tiles shared with a neighbouring submap
+            std::vector<tripoint> entrances;
+            // For each entrance, the tile across the submap border it leads to
+            std::vector<tripoint> exits;
+            // For each entrance, the cost of stepping onto its exit
+            std::vector<float> exit_costs;
+            // Cheapest cost of going from entrance `i` to entrance `j` without leaving the submap,
+            //   at `i * entrances.size() + j`
+            std::vector<float> paths;
+        };
+
         // Global state: allocated dijikstra d_maps. Pull to `d_maps` from here.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps_store;
 
@@ -242,6 +290,20 @@ class Pathfinding
         // Global state: We cache `z_path` information taken to prevent multiple iterations for the same target
         static std::map<std::tuple<bool, int, tripoint>, ZLevelChange> cached_closest_z_changes;
 
+        // Global state: coarse graph of the submaps of the reality bubble, keyed by absolute submap position.
+        //   Built on demand and dropped when terrain in or next to a submap changes.
+        //   Indexed by whether the route can open doors, which changes what is walkable.
+        static std::array<std::unordered_map<tripoint, Cluster>, 2> clusters;
+        // Global state: `map::get_abs_sub` when clusters outside of the map were last dropped
+        static tripoint cluster_area;
+
+        // Global state: counters since game start, or the last `reset_stats`
+        static pathfinding_stats stats;
+        // Global state: `stats` as they were at the end of the previous turn
+        static pathfinding_stats stats_at_turn_start;
+        // Global state: counters of the previous turn
+        static pathfinding_stats last_turn_stats;
+
         // Smallest adjacent f
         std::array<std::array<float, MAPSIZE_X>, MAPSIZE_Y> p_map;
         // Associated tile's g cost [movement, bashing down...]
@@ -285,6 +347,9 @@ class Pathfinding
 
         static void produce_d_map( point dest, int z, PathfindingSettings settings );
 
+        // Get the cluster of submap `abs_sm`, building it if needed. nullptr if the submap is not loaded.
+        static const Cluster *get_cluster( const tripoint &abs_sm, bool can_open_doors );
+
         // Get `p`-value at `p`
         float &p_at( const point &p );
         // Get `g`-value at `p`
@@ -314,6 +379,12 @@ class Pathfinding
             const point from, const point to, const int z,
             const PathfindingSettings path_settings,
             const RouteSettings route_settings );
+        // Plan a route over submap clusters, then refine it with `get_route_2d` one submap at a time.
+        //   Empty if either step fails.
+        static std::vector<tripoint> get_route_hierarchical(
+            const point from, const point to, const int z,
+            const PathfindingSettings &path_settings,
+            const RouteSettings &route_settings );
         // See `Pathfinding::route`
         static std::vector<tripoint> get_route_3d(
             const tripoint from, const tripoint to,
@@ -336,5 +407,20 @@ class Pathfinding
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
+
+        // Drop the clusters affected by a change of the tile at absolute map square `p`
+        static void mark_dirty_cluster( const tripoint &p );
+        // Drop the clusters affected by (re)loading submap `abs_sm`
+        static void mark_dirty_submap( const tripoint &abs_sm );
+
+        // Counters since game start, or the last `reset_stats`
+        static const pathfinding_stats &get_stats() {
+            return stats;
+        }
+        // Counters of the last full turn, updated by `clear_d_maps`
+        static const pathfinding_stats &get_last_turn_stats() {
+            return last_turn_stats;
+        }
+        static void reset_stats();
 };
 
@@ -75,9 +75,9 @@ void game::serialize( std::ostream &fout )
      * To prevent (or encourage) confusion, there is no version 8. (cata 0.8 uses v7)
      */
     // Header
-    fout << "# version " << savegame_version << '\n';
+    std::string data = "# version " + std::to_string( savegame_version ) + '\n';
 
-    JsonOut json( fout, true ); // pretty-print
+    JsonOut json( data, true ); // pretty-print
 
     json.start_object();
     // basic game state information.
@@ -122,6 +122,8 @@ void game::serialize( std::ostream &fout )
     Messages::serialize( json );
 
     json.end_object();
+
+    fout.write( data.data(), data.size() );
 }
 
 std::string scent_map::serialize( bool is_type ) const
@@ -412,7 +414,7 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        layer[z].terrain.set( point_om_omt( i, j ), tmp_otid );
                     }
                 }
                 jsin.end_array();
@@ -615,21 +617,19 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
     }
 }
 
-static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &array )[OMAPX][OMAPY] )
+static void unserialize_array_from_compacted_sequence( JsonIn &jsin, map_layer::flag_set &flags )
 {
     int count = 0;
     bool value = false;
-    for( int j = 0; j < OMAPY; j++ ) {
-        for( auto &array_col : array ) {
-            if( count == 0 ) {
-                jsin.start_array();
-                jsin.read( value );
-                jsin.read( count );
-                jsin.end_array();
-            }
-            count--;
-            array_col[j] = value;
+    for( size_t i = 0; i < flags.size(); i++ ) {
+        if( count == 0 ) {
+            jsin.start_array();
+            jsin.read( value );
+            jsin.read( count );
+            jsin.end_array();
         }
+        count--;
+        flags[i] = value;
     }
 }
 
@@ -703,26 +703,23 @@ void overmap::unserialize_view( std::istream &fin, const std::string &file_path
     }
 }
 
-static void serialize_array_to_compacted_sequence( JsonOut &json,
-        const bool ( &array )[OMAPX][OMAPY] )
+static void serialize_array_to_compacted_sequence( JsonOut &json, const map_layer::flag_set &flags )
 {
     int count = 0;
     int lastval = -1;
-    for( int j = 0; j < OMAPY; j++ ) {
-        for( const auto &array_col : array ) {
-            const int value = array_col[j];
-            if( value != lastval ) {
-                if( count ) {
-                    json.write( count );
-                    json.end_array();
-                }
-                lastval = value;
-                json.start_array();
-                json.write( static_cast<bool>( value ) );
-                count = 1;
-            } else {
-                count++;
+    for( size_t i = 0; i < flags.size(); i++ ) {
+        const int value = flags[i];
+        if( value != lastval ) {
+            if( count ) {
+                json.write( count );
+                json.end_array();
             }
+            lastval = value;
+            json.start_array();
+            json.write( static_cast<bool>( value ) );
+            count = 1;
+        } else {
+            count++;
         }
     }
     json.write( count );
@@ -876,14 +873,22 @@ void overmap::serialize( std::ostream &fout ) const
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        auto &layer_terrain = layer[z].terrain;
+        const map_layer_terrain &layer_terrain = layer[z].terrain;
+        json.start_array();
+        if( const oter_id *uniform = layer_terrain.uniform_id() ) {
+            json.start_array();
+            json.write( uniform->id() );
+            json.write( OMAPX * OMAPY );
+            json.end_array();
+            json.end_array();
+            fout << '\n';
+            continue;
+        }
         int count = 0;
         oter_id last_tertype( -1 );
-        json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
-            // NOLINTNEXTLINE(modernize-loop-convert)
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
+                oter_id t = layer_terrain.get( point_om_omt( i, j ) );
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
@@ -1272,6 +1277,8 @@ void Creature_tracker::deserialize( JsonIn &jsin )
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_bucket.clear();
+    bucket_keys.clear();
     jsin.start_array();
     while( !jsin.end_array() ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
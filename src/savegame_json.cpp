@@ -3783,12 +3783,12 @@ void submap::store( JsonOut &jsout ) const
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
         for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
+            if( !has_items( { i, j } ) ) {
                 continue;
             }
             jsout.write( i );
             jsout.write( j );
-            jsout.write( itm[i][j] );
+            jsout.write( *itm[i][j] );
         }
     }
     jsout.end_array();
@@ -3989,7 +3989,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                     tmp->legacy_fast_forward_time();
                 }
                 item &obj = *tmp;
-                itm[p.x][p.y].push_back( std::move( tmp ) );
+                get_items( p ).push_back( std::move( tmp ) );
                 if( obj.needs_processing() ) {
                     active_items.add( obj );
                 }
@@ -3997,10 +3997,13 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
         }
         for( auto &it1 : itm ) {
             for( auto &it2 : it1 ) {
-                std::vector<detached_ptr<item>> cleared = it2.clear();
+                if( !it2 ) {
+                    continue;
+                }
+                std::vector<detached_ptr<item>> cleared = it2->clear();
                 to_cbc_migration::migrate( cleared );
                 for( detached_ptr<item> &item : cleared ) {
-                    it2.push_back( std::move( item ) );
+                    it2->push_back( std::move( item ) );
                 }
             }
         }
@@ -14,6 +14,7 @@
 #include "generic_factory.h"
 #include "map.h"
 #include "output.h"
+#include "profile.h"
 #include "string_id.h"
 
 static constexpr int SCENT_RADIUS = 40;
@@ -149,6 +150,8 @@ bool scent_map::inbounds( const tripoint &p ) const
 }
 void scent_map::update( const tripoint &center, map &m )
 {
+    ZoneScoped;
+
     // Stop updating scent after X turns of the player not moving.
     // Once wind is added, need to reset this on wind shifts as well.
     if( !player_last_position || center != *player_last_position ) {
@@ -158,88 +161,132 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
+    // Squares that get a new value, and the ones around them that scent diffuses from
+    const half_open_rectangle<point> area( center.xy() - point( SCENT_RADIUS, SCENT_RADIUS ),
+                                           center.xy() + point( SCENT_RADIUS + 1, SCENT_RADIUS + 1 ) );
+    const half_open_rectangle<point> sources( area.p_min - point_south_east,
+            area.p_max + point_south_east );
+
+    // Squares without scent anywhere around them stay at zero, so only the part of the area
+    // around the scent that is actually there needs to be computed.
+    point scent_min = sources.p_max;
+    point scent_max = sources.p_min - point_south_east;
+    for( int x = sources.p_min.x; x < sources.p_max.x; ++x ) {
+        const std::array<int, MAPSIZE_Y> &column = grscent[x];
+        int first = sources.p_min.y;
+        while( first < sources.p_max.y && column[first] == 0 ) {
+            first++;
+        }
+        if( first == sources.p_max.y ) {
+            continue;
+        }
+        int last = sources.p_max.y - 1;
+        while( column[last] == 0 ) {
+            last--;
+        }
+        scent_min = point( std::min( scent_min.x, x ), std::min( scent_min.y, first ) );
+        scent_max = point( std::max( scent_max.x, x ), std::max( scent_max.y, last ) );
+    }
+    const point min( std::max( scent_min.x - 1, area.p_min.x ),
+                     std::max( scent_min.y - 1, area.p_min.y ) );
+    const point max( std::min( scent_max.x + 1, area.p_max.x - 1 ),
+                     std::min( scent_max.y + 1, area.p_max.y - 1 ) );
+    if( min.x > max.x || min.y > max.y ) {
+        return;
+    }
+    const int width = max.x - min.x + 1;
+    const int height = max.y - min.y + 1;
+
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
     scent_array<char> scent_transfer;
+    // The new scent flag searching function. Should be wayyy faster than the old one.
+    m.scent_blockers( scent_transfer, min - point_south_east, max + point_south_east );
 
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
-
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+    const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
-
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    // Indexed like grscent, relative to min, with an extra column on each side for
+    // the sums along y. Columns are contiguous, so the loops over y vectorize.
+    static constexpr int max_size = SCENT_RADIUS * 2 + 3;
+    std::array<std::array<int, max_size>, max_size> sum_3_scent_y;
+    std::array<std::array<int, max_size>, max_size> squares_used_y;
+    std::array<std::array<int, max_size>, max_size> new_scent;
+
+    // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+    for( int lx = 0; lx < width + 2; ++lx ) {
+        const int x = min.x - 1 + lx;
+        const int *const scent = grscent[x].data() + min.y;
+        const char *const transfer = scent_transfer[x].data() + min.y;
+        int *const sum = sum_3_scent_y[lx].data();
+        int *const used = squares_used_y[lx].data();
+        for( int ly = 0; ly < height; ++ly ) {
+            sum[ly] = transfer[ly - 1] * scent[ly - 1] + transfer[ly] * scent[ly] +
+                      transfer[ly + 1] * scent[ly + 1];
+            used[ly] = transfer[ly - 1] + transfer[ly] + transfer[ly + 1];
+        }
     }
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+    for( int lx = 0; lx < width; ++lx ) {
+        const int x = min.x + lx;
+        const int *const scent = grscent[x].data() + min.y;
+        const char *const transfer = scent_transfer[x].data() + min.y;
+        int *const out = new_scent[lx].data();
+        for( int ly = 0; ly < height; ++ly ) {
+            const int squares_used = squares_used_y[lx][ly] + squares_used_y[lx + 1][ly] +
+                                     squares_used_y[lx + 2][ly];
+            const int total = sum_3_scent_y[lx][ly] + sum_3_scent_y[lx + 1][ly] + sum_3_scent_y[lx + 2][ly];
 
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            //Lingering scent
+            int temp_scent = scent[ly] * ( 250 - squares_used * transfer[ly] );
+            temp_scent -= scent[ly] * transfer[ly] * ( 45 - squares_used ) / 5;
 
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+            out[ly] = ( temp_scent + total * transfer[ly] ) / 250;
         }
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-            //handle vehicle holes
-            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+    //handle vehicle holes
+    //Rare, so these squares are computed again with the diagonal neighbors left out
+    for( int lx = 0; lx < width; ++lx ) {
+        const int x = min.x + lx;
+        for( int ly = 0; ly < height; ++ly ) {
+            const int y = min.y + ly;
+            const bool nw = blocked_cache[x][y].nw && scent_transfer[x + 1][y + 1] == 5;
+            const bool ne = blocked_cache[x][y].ne && scent_transfer[x - 1][y + 1] == 5;
+            const bool se = blocked_cache[x - 1][y - 1].nw && scent_transfer[x - 1][y - 1] == 5;
+            const bool sw = blocked_cache[x + 1][y - 1].ne && scent_transfer[x + 1][y - 1] == 5;
+            if( !nw && !ne && !se && !sw ) {
+                continue;
+            }
+            int squares_used = squares_used_y[lx][ly] + squares_used_y[lx + 1][ly] +
+                               squares_used_y[lx + 2][ly];
+            int total = sum_3_scent_y[lx][ly] + sum_3_scent_y[lx + 1][ly] + sum_3_scent_y[lx + 2][ly];
+            if( nw ) {
                 squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+                total -= 4 * grscent[x + 1][y + 1];
             }
-            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+            if( ne ) {
                 squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+                total -= 4 * grscent[x - 1][y + 1];
             }
-            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+            if( se ) {
                 squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+                total -= 4 * grscent[x - 1][y - 1];
             }
-            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+            if( sw ) {
                 squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+                total -= 4 * grscent[x + 1][y - 1];
             }
-
-            //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
+            const int scent = grscent[x][y];
+            const int transfer = scent_transfer[x][y];
+            int temp_scent = scent * ( 250 - squares_used * transfer );
+            temp_scent -= scent * transfer * ( 45 - squares_used ) / 5;
+            new_scent[lx][ly] = ( temp_scent + total * transfer ) / 250;
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+
+    for( int lx = 0; lx < width; ++lx ) {
+        std::copy_n( new_scent[lx].begin(), height, grscent[min.x + lx].begin() + min.y );
     }
 }
 
@@ -0,0 +1,262 @@
+#include "shadowcasting.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define CATA_SHADOWCASTING_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 is not part of the x86-64 baseline, so it is only compiled for the functions that use it
+// and selected at runtime. MSVC lacks the per-function target attribute, so it stays at SSE2.
+#if defined(CATA_SHADOWCASTING_SSE2) && defined(__GNUC__) && defined(__x86_64__)
+#define CATA_SHADOWCASTING_AVX2
+#include <immintrin.h>
+#define CATA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+
+bool kernel_supported( shadowcasting_kernel kernel )
+{
+    switch( kernel ) {
+        case shadowcasting_kernel::per_cell:
+        case shadowcasting_kernel::scalar:
+            return true;
+        case shadowcasting_kernel::sse2:
+#if defined(CATA_SHADOWCASTING_SSE2)
+            return true;
+#else
+            return false;
+#endif
+        case shadowcasting_kernel::avx2:
+#if defined(CATA_SHADOWCASTING_AVX2)
+            return __builtin_cpu_supports( "avx2" );
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+shadowcasting_kernel detect_best_kernel()
+{
+    for( shadowcasting_kernel kernel : {
+             shadowcasting_kernel::avx2, shadowcasting_kernel::sse2
+         } ) {
+        if( kernel_supported( kernel ) ) {
+            return kernel;
+        }
+    }
+    return shadowcasting_kernel::scalar;
+}
+
+std::atomic<shadowcasting_kernel> &active_kernel()
+{
+    static std::atomic<shadowcasting_kernel> kernel( best_shadowcasting_kernel() );
+    return kernel;
+}
+
+int count_equal_forward_scalar( const float *first, int len, float value )
+{
+    int i = 0;
+    while( i < len && first[i] == value ) {
+        i++;
+    }
+    return i;
+}
+
+int count_equal_backward_scalar( const float *last, int len, float value )
+{
+    int i = 0;
+    while( i < len && *( last - i ) == value ) {
+        i++;
+    }
+    return i;
+}
+
+void max_into_scalar( float *dst, const float *src, int len )
+{
+    for( int i = 0; i < len; i++ ) {
+        dst[i] = std::max( dst[i], src[i] );
+    }
+}
+
+#if defined(CATA_SHADOWCASTING_SSE2)
+int count_equal_forward_sse2( const float *first, int len, float value )
+{
+    const __m128 v = _mm_set1_ps( value );
+    int i = 0;
+    for( ; i + 4 <= len; i += 4 ) {
+        const int mask = _mm_movemask_ps( _mm_cmpeq_ps( _mm_loadu_ps( first + i ), v ) );
+        if( mask != 0xF ) {
+            return i + std::countr_one( static_cast<unsigned int>( mask ) );
+        }
+    }
+    return i + count_equal_forward_scalar( first + i, len - i, value );
+}
+
+int count_equal_backward_sse2( const float *last, int len, float value )
+{
+    const __m128 v = _mm_set1_ps( value );
+    int i = 0;
+    for( ; i + 4 <= len; i += 4 ) {
+        const int mask = _mm_movemask_ps( _mm_cmpeq_ps( _mm_loadu_ps( last - i - 3 ), v ) );
+        if( mask != 0xF ) {
+            // Highest lane is the one closest to last
+            return i + std::countl_one( static_cast<std::uint8_t>( mask << 4 ) );
+        }
+    }
+    return i + count_equal_backward_scalar( last - i, len - i, value );
+}
+
+void max_into_sse2( float *dst, const float *src, int len )
+{
+    int i = 0;
+    for( ; i + 4 <= len; i += 4 ) {
+        // Operand order matches std::max( dst, src ), which keeps dst unless src is larger
+        _mm_storeu_ps( dst + i, _mm_max_ps( _mm_loadu_ps( src + i ), _mm_loadu_ps( dst + i ) ) );
+    }
+    max_into_scalar( dst + i, src + i, len - i );
+}
+#endif
+
+#if defined(CATA_SHADOWCASTING_AVX2)
+CATA_TARGET_AVX2
+int count_equal_forward_avx2( const float *first, int len, float value )
+{
+    const __m256 v = _mm256_set1_ps( value );
+    int i = 0;
+    for( ; i + 8 <= len; i += 8 ) {
+        const int mask = _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( first + i ), v,
+                                             _CMP_EQ_OQ ) );
+        if( mask != 0xFF ) {
+            return i + std::countr_one( static_cast<unsigned int>( mask ) );
+        }
+    }
+    return i + count_equal_forward_sse2( first + i, len - i, value );
+}
+
+CATA_TARGET_AVX2
+int count_equal_backward_avx2( const float *last, int len, float value )
+{
+    const __m256 v = _mm256_set1_ps( value );
+    int i = 0;
+    for( ; i + 8 <= len; i += 8 ) {
+        const int mask = _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( last - i - 7 ), v,
+                                             _CMP_EQ_OQ ) );
+        if( mask != 0xFF ) {
+            return i + std::countl_one( static_cast<std::uint8_t>( mask ) );
+        }
+    }
+    return i + count_equal_backward_sse2( last - i, len - i, value );
+}
+
+CATA_TARGET_AVX2
+void max_into_avx2( float *dst, const float *src, int len )
+{
+    int i = 0;
+    for( ; i + 8 <= len; i += 8 ) {
+        _mm256_storeu_ps( dst + i, _mm256_max_ps( _mm256_loadu_ps( src + i ),
+                          _mm256_loadu_ps( dst + i ) ) );
+    }
+    max_into_sse2( dst + i, src + i, len - i );
+}
+#endif
+
+} // namespace
+
+shadowcasting_kernel best_shadowcasting_kernel()
+{
+    static const shadowcasting_kernel best = detect_best_kernel();
+    return best;
+}
+
+shadowcasting_kernel get_shadowcasting_kernel()
+{
+    return active_kernel().load( std::memory_order_relaxed );
+}
+
+shadowcasting_kernel set_shadowcasting_kernel( shadowcasting_kernel kernel )
+{
+    if( !kernel_supported( kernel ) ) {
+        kernel = best_shadowcasting_kernel();
+    }
+    active_kernel().store( kernel, std::memory_order_relaxed );
+    return kernel;
+}
+
+std::string shadowcasting_kernel_name( shadowcasting_kernel kernel )
+{
+    switch( kernel ) {
+        case shadowcasting_kernel::per_cell:
+            return "per_cell";
+        case shadowcasting_kernel::scalar:
+            return "scalar";
+        case shadowcasting_kernel::sse2:
+            return "sse2";
+        case shadowcasting_kernel::avx2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+namespace shadowcasting_rows
+{
+
+int count_equal_forward( const float *first, int len, float value )
+{
+    switch( get_shadowcasting_kernel() ) {
+#if defined(CATA_SHADOWCASTING_AVX2)
+        case shadowcasting_kernel::avx2:
+            return count_equal_forward_avx2( first, len, value );
+#endif
+#if defined(CATA_SHADOWCASTING_SSE2)
+        case shadowcasting_kernel::sse2:
+            return count_equal_forward_sse2( first, len, value );
+#endif
+        default:
+            return count_equal_forward_scalar( first, len, value );
+    }
+}
+
+int count_equal_backward( const float *last, int len, float value )
+{
+    switch( get_shadowcasting_kernel() ) {
+#if defined(CATA_SHADOWCASTING_AVX2)
+        case shadowcasting_kernel::avx2:
+            return count_equal_backward_avx2( last, len, value );
+#endif
+#if defined(CATA_SHADOWCASTING_SSE2)
+        case shadowcasting_kernel::sse2:
+            return count_equal_backward_sse2( last, len, value );
+#endif
+        default:
+            return count_equal_backward_scalar( last, len, value );
+    }
+}
+
+void max_into( float *dst, const float *src, int len )
+{
+    switch( get_shadowcasting_kernel() ) {
+#if defined(CATA_SHADOWCASTING_AVX2)
+        case shadowcasting_kernel::avx2:
+            max_into_avx2( dst, src, len );
+            return;
+#endif
+#if defined(CATA_SHADOWCASTING_SSE2)
+        case shadowcasting_kernel::sse2:
+            max_into_sse2( dst, src, len );
+            return;
+#endif
+        default:
+            max_into_scalar( dst, src, len );
+            return;
+    }
+}
+
+} // namespace shadowcasting_rows
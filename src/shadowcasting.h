@@ -128,6 +128,41 @@ void castLightAllWithLookup( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                              const diagonal_blocks( &blocked_array )[MAPSIZE_X][MAPSIZE_Y],
                              const point &offset, int offsetDistance = 0, T numerator = 1.0 );
 
+/**
+ * Implementation used by castLight for the rows of the seen cache.
+ * Rows that run along the contiguous axis of the caches are processed in batches
+ * of cells sharing the same transparency instead of one cell at a time.
+ */
+enum class shadowcasting_kernel : int {
+    // Original cell by cell loop, no batching.
+    per_cell,
+    // Batched rows, plain C++.
+    scalar,
+    sse2,
+    avx2,
+};
+
+/** Returns the fastest kernel supported by the CPU we are running on. */
+shadowcasting_kernel best_shadowcasting_kernel();
+/** Kernel currently used by castLight. Defaults to best_shadowcasting_kernel(). */
+shadowcasting_kernel get_shadowcasting_kernel();
+/**
+ * Selects the kernel used by castLight. Kernels not supported by the CPU
+ * are replaced with the best supported one. Returns the selected kernel.
+ */
+shadowcasting_kernel set_shadowcasting_kernel( shadowcasting_kernel kernel );
+std::string shadowcasting_kernel_name( shadowcasting_kernel kernel );
+
+namespace shadowcasting_rows
+{
+/** Number of leading elements of [first, first + len) equal to @p value. */
+int count_equal_forward( const float *first, int len, float value );
+/** Number of trailing elements of [last - len + 1, last] equal to @p value, counted from @p last. */
+int count_equal_backward( const float *last, int len, float value );
+/** dst[i] = max( dst[i], src[i] ) for i in [0, len). */
+void max_into( float *dst, const float *src, int len );
+} // namespace shadowcasting_rows
+
 template<typename T>
 using array_of_grids_of = std::array<T( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS>;
 
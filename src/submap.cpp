@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "int_id.h"
+#include "locations.h"
 #include "mapdata.h"
 #include "tileray.h"
 #include "trap.h"
@@ -21,7 +22,16 @@ void maptile_soa<sx, sy>::swap_soa_tile( point p1, point p2 )
     std::swap( ter[p1.x][p1.y], ter[p2.x][p2.y] );
     std::swap( frn[p1.x][p1.y], frn[p2.x][p2.y] );
     std::swap( lum[p1.x][p1.y], lum[p2.x][p2.y] );
-    std::swap( itm[p1.x][p1.y], itm[p2.x][p2.y] );
+    // Locations stay with their square, only the items trade places
+    if( itm[p1.x][p1.y] || itm[p2.x][p2.y] ) {
+        if( !itm[p1.x][p1.y] ) {
+            allocate_items( p1 );
+        }
+        if( !itm[p2.x][p2.y] ) {
+            allocate_items( p2 );
+        }
+        std::swap( *itm[p1.x][p1.y], *itm[p2.x][p2.y] );
+    }
     std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
     std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
@@ -51,178 +61,26 @@ void submap::swap( submap &first, submap &second )
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
-            std::swap( first.itm[x][y], second.itm[x][y] );
+            if( first.itm[x][y] || second.itm[x][y] ) {
+                std::swap( first.get_items( { x, y } ), second.get_items( { x, y } ) );
+            }
         }
     }
 }
 
-//There's not a briefer way to write this I don't think
 template<int sx, int sy>
-maptile_soa<sx, sy>::maptile_soa( tripoint offset ) : itm{{
-        // NOLINTNEXTLINE(cata-use-named-point-constants)
-        location_vector{ new tile_item_location( offset + point( 0, 0 ) )},
-        // NOLINTNEXTLINE(cata-use-named-point-constants)
-        location_vector{ new tile_item_location( offset + point( 0, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 0, 11 ) )},
-    },
-    {
-        // NOLINTNEXTLINE(cata-use-named-point-constants)
-        location_vector{ new tile_item_location( offset + point( 1, 0 ) )},
-        // NOLINTNEXTLINE(cata-use-named-point-constants)
-        location_vector{ new tile_item_location( offset + point( 1, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 1, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 2, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 2, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 3, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 3, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 4, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 4, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 5, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 5, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 6, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 6, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 7, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 7, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 8, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 8, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 9, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 9, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 10, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 10, 11 ) )},
-    }, {
-        location_vector{ new tile_item_location( offset + point( 11, 0 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 1 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 2 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 3 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 4 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 5 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 6 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 7 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 8 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 9 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 10 ) )},
-        location_vector{ new tile_item_location( offset + point( 11, 11 ) )},
-    }}
+maptile_soa<sx, sy>::maptile_soa( tripoint offset ) : offset( offset )
+{
+}
+
+template<int sx, int sy>
+void maptile_soa<sx, sy>::allocate_items( point p )
 {
+    itm[p.x][p.y] = std::make_unique<location_vector<item>>( new tile_item_location( offset + p ) );
 }
 
+template struct maptile_soa<SEEX, SEEY>;
+
 submap::submap( tripoint offset ) : maptile_soa<SEEX, SEEY>( offset )
 {
     std::uninitialized_fill_n( &ter[0][0], elements, t_null );
@@ -236,6 +94,42 @@ submap::submap( tripoint offset ) : maptile_soa<SEEX, SEEY>( offset )
 
 submap::~submap() = default;
 
+const location_vector<item> &submap::get_items( const point &p ) const
+{
+    static const location_vector<item> no_items( new tile_item_location( tripoint_min ) );
+    return itm[p.x][p.y] ? *itm[p.x][p.y] : no_items;
+}
+
+void submap::shrink_items()
+{
+    for( auto &column : itm ) {
+        for( std::unique_ptr<location_vector<item>> &items : column ) {
+            if( items && items->empty() ) {
+                items.reset();
+            }
+        }
+    }
+}
+
+size_t submap::item_storage_bytes() const
+{
+    size_t bytes = sizeof( itm );
+    for( const auto &column : itm ) {
+        for( const std::unique_ptr<location_vector<item>> &items : column ) {
+            if( items ) {
+                bytes += sizeof( location_vector<item> ) + sizeof( tile_item_location ) +
+                         items->as_vector().capacity() * sizeof( item * );
+            }
+        }
+    }
+    return bytes;
+}
+
+size_t submap::dense_item_storage_bytes()
+{
+    return elements * ( sizeof( location_vector<item> ) + sizeof( tile_item_location ) );
+}
+
 void submap::update_lum_rem( point p, const item &i )
 {
     is_uniform = false;
@@ -249,7 +143,7 @@ void submap::update_lum_rem( point p, const item &i )
     // Have to scan through all items to be sure removing i will actually lower
     // the count below 255.
     int count = 0;
-    for( const auto &it : itm[p.x][p.y] ) {
+    for( const auto &it : get_items( p ) ) {
         if( it->is_emissive() ) {
             count++;
         }
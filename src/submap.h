@@ -7,6 +7,7 @@
 #include <string>
 #include <iterator>
 #include <map>
+#include <utility>
 
 #include "active_item_cache.h"
 #include "active_tile_data.h"
@@ -74,12 +75,23 @@ struct maptile_soa {
         ter_id             ter[sx][sy];  // Terrain on each square
         furn_id            frn[sx][sy];  // Furniture on each square
         std::uint8_t       lum[sx][sy];  // Number of items emitting light on each square
-        location_vector<item> itm[sx][sy]; // Items on each square
+        /**
+         * Items on each square. Most squares never hold an item, so lists and their
+         * locations are only allocated by @ref allocate_items, null means no items.
+         */
+        std::unique_ptr<location_vector<item>> itm[sx][sy];
         field              fld[sx][sy];  // Field on each square
         trap_id            trp[sx][sy];  // Trap on each square
         int                rad[sx][sy];  // Irradiation of each square
 
         void swap_soa_tile( point p1, point p2 );
+
+    protected:
+        /** Absolute position of square (0,0), to place item locations created later. */
+        tripoint offset;
+
+        /** Give the square an empty item list, so items can be added to it. */
+        void allocate_items( point p );
 };
 
 class submap : maptile_soa<SEEX, SEEY>
@@ -155,14 +167,32 @@ class submap : maptile_soa<SEEX, SEEY>
         void update_lum_rem( point p, const item &i );
 
         // TODO: Replace this as it essentially makes itm public
+        /** Items on the square, which gets an item list if it had none. */
         location_vector<item> &get_items( const point &p ) {
-            return itm[p.x][p.y];
+            if( !itm[p.x][p.y] ) {
+                allocate_items( p );
+            }
+            return *itm[p.x][p.y];
         }
 
-        const location_vector<item> &get_items( const point &p ) const {
-            return itm[p.x][p.y];
+        /** Items on the square, squares without an item list share an empty one. */
+        const location_vector<item> &get_items( const point &p ) const;
+
+        bool has_items( const point &p ) const {
+            return itm[p.x][p.y] && !itm[p.x][p.y]->empty();
         }
 
+        /**
+         * Free item lists of empty squares. Lists must not be in use, as anything
+         * that kept a reference to them (e.g. a map_stack) would be left dangling.
+         */
+        void shrink_items();
+
+        /** Heap and inline memory used for items lists, not counting the items themselves. */
+        size_t item_storage_bytes() const;
+        /** Memory item lists would use if every square had one, as before they were allocated lazily. */
+        static size_t dense_item_storage_bytes();
+
         // TODO: Replace this as it essentially makes fld public
         field &get_field( point p ) {
             return fld[p.x][p.y];
@@ -321,12 +351,12 @@ struct maptile {
 
         // For map::draw_maptile
         size_t get_item_count() const {
-            return sm->get_items( pos() ).size();
+            return std::as_const( *sm ).get_items( pos() ).size();
         }
 
         // Assumes there is at least one item
         const item &get_uppermost_item() const {
-            return **std::prev( sm->get_items( pos() ).cend() );
+            return **std::prev( std::as_const( *sm ).get_items( pos() ).cend() );
         }
 };
 
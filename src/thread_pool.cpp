@@ -0,0 +1,158 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "profile.h"
+
+namespace cata
+{
+
+namespace
+{
+
+constexpr size_t no_worker = static_cast<size_t>( -1 );
+
+// Identifies the worker (and its pool) running on the current thread, so tasks
+// submitted from inside a task land in the submitting worker's own queue.
+thread_local const thread_pool *current_pool = nullptr;
+thread_local size_t current_worker = no_worker;
+
+} // namespace
+
+thread_pool::thread_pool( size_t num_workers )
+{
+    const size_t num_queues = std::max<size_t>( 1, num_workers );
+    queues.reserve( num_queues );
+    for( size_t i = 0; i < num_queues; ++i ) {
+        queues.emplace_back( std::make_unique<worker_queue>() );
+    }
+    workers.reserve( num_workers );
+    for( size_t i = 0; i < num_workers; ++i ) {
+        workers.emplace_back( &thread_pool::worker_loop, this, i );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+        stopping = true;
+    }
+    wake_up.notify_all();
+    for( std::thread &t : workers ) {
+        t.join();
+    }
+    // Without workers nothing ran the queue, make sure no future is left hanging.
+    job j;
+    while( try_pop( 0, j ) ) {
+        j.run( true );
+    }
+}
+
+void thread_pool::push( job &&j, task_priority priority )
+{
+    size_t target;
+    if( current_pool == this && current_worker != no_worker ) {
+        target = current_worker;
+    } else {
+        target = next_queue.fetch_add( 1, std::memory_order_relaxed ) % queues.size();
+    }
+    // Count the task before it becomes visible so that a thief can never
+    // decrement the counter below zero.
+    pending.fetch_add( 1 );
+    {
+        worker_queue &q = *queues[target];
+        std::lock_guard<std::mutex> lk( q.mutex );
+        q.jobs[static_cast<size_t>( priority )].push_back( std::move( j ) );
+    }
+    TracyPlot( "Thread pool pending", static_cast<int64_t>( pending.load() ) );
+    {
+        // Lock so a worker can't miss the notification between its check and its wait.
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+    }
+    wake_up.notify_one();
+}
+
+bool thread_pool::try_pop( size_t home, job &out )
+{
+    const size_t num_queues = queues.size();
+    for( size_t prio = 0; prio < static_cast<size_t>( task_priority::num_priorities ); ++prio ) {
+        for( size_t offset = 0; offset < num_queues; ++offset ) {
+            worker_queue &q = *queues[( home + offset ) % num_queues];
+            std::lock_guard<std::mutex> lk( q.mutex );
+            std::deque<job> &jobs = q.jobs[prio];
+            if( jobs.empty() ) {
+                continue;
+            }
+            // Own queue is consumed in submission order, stolen work comes from the back.
+            if( offset == 0 ) {
+                out = std::move( jobs.front() );
+                jobs.pop_front();
+            } else {
+                out = std::move( jobs.back() );
+                jobs.pop_back();
+            }
+            pending.fetch_sub( 1 );
+            return true;
+        }
+    }
+    return false;
+}
+
+void thread_pool::execute( job &j )
+{
+    ZoneScopedN( "thread_pool_task" );
+    if( j.name ) {
+        ZoneText( j.name, std::strlen( j.name ) );
+    }
+    active.fetch_add( 1 );
+    TracyPlot( "Thread pool active", static_cast<int64_t>( active.load() ) );
+    j.run( j.token.is_cancelled() );
+    active.fetch_sub( 1 );
+}
+
+bool thread_pool::run_pending_task()
+{
+    const size_t home = current_pool == this && current_worker != no_worker ? current_worker : 0;
+    job j;
+    if( !try_pop( home, j ) ) {
+        return false;
+    }
+    execute( j );
+    return true;
+}
+
+void thread_pool::worker_loop( size_t index )
+{
+    current_pool = this;
+    current_worker = index;
+    while( true ) {
+        job j;
+        if( try_pop( index, j ) ) {
+            execute( j );
+            continue;
+        }
+        std::unique_lock<std::mutex> lk( sleep_mutex );
+        wake_up.wait( lk, [this]() {
+            return stopping || pending.load() > 0;
+        } );
+        if( stopping && pending.load() == 0 ) {
+            return;
+        }
+    }
+}
+
+size_t default_thread_pool_size()
+{
+    const unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 1;
+}
+
+thread_pool &get_thread_pool()
+{
+    static thread_pool pool( default_thread_pool_size() );
+    return pool;
+}
+
+} // namespace cata
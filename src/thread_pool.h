@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cata
+{
+
+enum class task_priority : int {
+    high = 0,
+    normal,
+    low,
+    num_priorities
+};
+
+/** Thrown from the future of a task that was cancelled before it started. */
+class task_cancelled : public std::runtime_error
+{
+    public:
+        task_cancelled() : std::runtime_error( "task cancelled" ) {}
+};
+
+/**
+ * Shared flag used to cancel a group of submitted tasks.
+ *
+ * Tasks that have not started yet when the token is cancelled are dropped,
+ * tasks that are already running may poll @ref is_cancelled to stop early.
+ * Default-constructed tokens can be cancelled too, copies share the same flag.
+ */
+class cancellation_token
+{
+    public:
+        cancellation_token() : flag( std::make_shared<std::atomic<bool>>( false ) ) {}
+
+        void cancel() {
+            flag->store( true, std::memory_order_relaxed );
+        }
+        bool is_cancelled() const {
+            return flag->load( std::memory_order_relaxed );
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> flag;
+};
+
+/**
+ * @brief Persistent pool of worker threads with per-worker queues and work stealing.
+ *
+ * Each worker owns one queue per priority.  Workers take tasks from the front
+ * of their own queue and, when it runs dry, steal from the back of the queues
+ * of other workers.  Higher priority tasks are always preferred over lower
+ * priority ones, regardless of which queue they are in.
+ *
+ * Tasks must not block waiting on other tasks of the same pool, use
+ * @ref run_pending_task to help out instead.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( size_t num_workers );
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+        ~thread_pool();
+
+        /**
+         * Queue @p func for execution on a worker thread.
+         * @param name Static string shown in the profiler zone of the task.
+         * @returns Future holding the result of @p func, or @ref task_cancelled
+         * if @p token was cancelled before the task started.
+         */
+        template<typename F>
+        auto submit( F &&func, task_priority priority = task_priority::normal,
+                     const char *name = nullptr,
+                     cancellation_token token = cancellation_token() )
+        -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using result_t = std::invoke_result_t<std::decay_t<F>>;
+            struct task_state {
+                std::decay_t<F> func;
+                std::promise<result_t> promise;
+            };
+            auto state = std::make_shared<task_state>( task_state{ std::forward<F>( func ), {} } );
+            std::future<result_t> result = state->promise.get_future();
+
+            job j;
+            j.name = name;
+            j.token = std::move( token );
+            j.run = [state]( bool cancelled ) {
+                if( cancelled ) {
+                    state->promise.set_exception( std::make_exception_ptr( task_cancelled() ) );
+                    return;
+                }
+                try {
+                    if constexpr( std::is_void_v<result_t> ) {
+                        state->func();
+                        state->promise.set_value();
+                    } else {
+                        state->promise.set_value( state->func() );
+                    }
+                } catch( ... ) {
+                    state->promise.set_exception( std::current_exception() );
+                }
+            };
+            push( std::move( j ), priority );
+            return result;
+        }
+
+        /**
+         * Run a single queued task on the calling thread, if there is one.
+         * Lets a thread that waits on results contribute instead of idling.
+         * @returns true if a task was run.
+         */
+        bool run_pending_task();
+
+        /**
+         * Block until @p f is ready, running queued tasks on the calling thread meanwhile.
+         */
+        template<typename T>
+        void help_until_ready( const std::future<T> &f ) {
+            while( f.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+                if( !run_pending_task() ) {
+                    f.wait();
+                }
+            }
+        }
+
+        size_t num_workers() const {
+            return workers.size();
+        }
+        /** Number of tasks queued but not yet started. */
+        size_t num_pending() const {
+            return pending.load( std::memory_order_relaxed );
+        }
+        /** Number of tasks currently executing. */
+        size_t num_active() const {
+            return active.load( std::memory_order_relaxed );
+        }
+
+    private:
+        struct job {
+            std::function<void( bool )> run;
+            cancellation_token token;
+            const char *name = nullptr;
+        };
+        struct worker_queue {
+            std::mutex mutex;
+            std::array<std::deque<job>, static_cast<size_t>( task_priority::num_priorities )> jobs;
+        };
+
+        void push( job &&j, task_priority priority );
+        bool try_pop( size_t home, job &out );
+        void execute( job &j );
+        void worker_loop( size_t index );
+
+        std::vector<std::unique_ptr<worker_queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake_up;
+        std::atomic<size_t> pending{ 0 };
+        std::atomic<size_t> active{ 0 };
+        std::atomic<size_t> next_queue{ 0 };
+        bool stopping = false;
+};
+
+/** Number of workers used for the shared pool, one less than the number of hardware threads. */
+size_t default_thread_pool_size();
+
+/** Shared pool used by all parallel passes of the game. */
+thread_pool &get_thread_pool();
+
+} // namespace cata
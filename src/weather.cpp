@@ -1152,9 +1152,29 @@ auto weather_manager::get_water_temperature( const tripoint & ) const -> units::
     return water_temperature;
 }
 
+auto weather_manager::get_weather_temperature( const tripoint_abs_ms &location,
+        time_point time ) const -> units::temperature
+{
+    const std::pair<point_abs_ms, int> key( location.xy(), to_turn<int>( time ) );
+    const auto cached = past_temperature_cache.find( key );
+    if( cached != past_temperature_cache.end() ) {
+        return cached->second;
+    }
+    // A whole season of catching up across a large base, start over instead of growing further
+    static constexpr size_t max_cached = 1 << 18;
+    if( past_temperature_cache.size() >= max_cached ) {
+        past_temperature_cache.clear();
+    }
+    const units::temperature temperature = get_cur_weather_gen().get_weather_temperature( location,
+                                           time, calendar::config, g->get_seed() );
+    past_temperature_cache.emplace( key, temperature );
+    return temperature;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    past_temperature_cache.clear();
 }
 
 namespace weather
@@ -3,6 +3,7 @@
 #include "calendar.h"
 #include "color.h"
 #include "coordinates.h"
+#include "hash_utils.h"
 #include "pimpl.h"
 #include "point.h"
 #include "type_id.h"
@@ -211,6 +212,17 @@ class weather_manager
         auto get_water_temperature( const tripoint &location ) const -> units::temperature;
         void clear_temp_cache();
 
+        /**
+         * Weather temperature at @p location and @p time, without local modifiers.
+         * Items returning to the reality bubble catch up on their rot hour by hour, items
+         * at the same place share those hours through @ref past_temperature_cache.
+         */
+        auto get_weather_temperature( const tripoint_abs_ms &location,
+                                      time_point time ) const -> units::temperature;
+        /** past weather temperature cache, cleared every turn, keyed by location and turn */
+        mutable std::unordered_map<std::pair<point_abs_ms, int>, units::temperature, cata::tuple_hash>
+        past_temperature_cache;
+
         // Get precise weather data
         const w_point &get_precise() const {
             return weather_precise;
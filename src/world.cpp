@@ -4,6 +4,13 @@
 #include <sstream>
 #include <cstring>
 #include <chrono>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 
 #include "game.h"
 #include "avatar.h"
@@ -16,6 +23,7 @@
 #include "path_info.h"
 #include "compress.h"
 #include "sqlite3.h"
+#include "thread_pool.h"
 #include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
@@ -55,6 +63,63 @@ static sqlite3 *open_db( const std::string &path )
     return db;
 }
 
+/**
+ * The format of a SQLite world is kept in the user_version header field of its map database.
+ * Databases created before there was more than one codec have it at 0.
+ */
+static save_format read_db_save_format( sqlite3 *db )
+{
+    int version = 0;
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "PRAGMA user_version", -1, &stmt, nullptr ) == SQLITE_OK &&
+        sqlite3_step( stmt ) == SQLITE_ROW ) {
+        version = sqlite3_column_int( stmt, 0 );
+    }
+    sqlite3_finalize( stmt );
+    return version == save_format::V2_LZ4_SQLITE3 ? save_format::V2_LZ4_SQLITE3 :
+           save_format::V2_COMPRESSED_SQLITE3;
+}
+
+static void write_db_save_format( sqlite3 *db, save_format format )
+{
+    const std::string sql = string_format( "PRAGMA user_version = %d", static_cast<int>( format ) );
+    sqlite3_exec( db, sql.c_str(), NULL, NULL, NULL );
+}
+
+bool save_format_uses_sqlite( save_format format )
+{
+    return format != save_format::V1;
+}
+
+compression_codec save_format_codec( save_format format )
+{
+    switch( format ) {
+        case save_format::V1:
+            return compression_codec::none;
+        case save_format::V2_COMPRESSED_SQLITE3:
+            return compression_codec::zlib;
+        case save_format::V2_LZ4_SQLITE3:
+            return compression_codec::lz4;
+    }
+    return compression_codec::zlib;
+}
+
+save_format detect_save_format( const std::string &world_path )
+{
+    const std::string map_db_path = world_path + "/map.sqlite3";
+    if( !file_exist( map_db_path ) ) {
+        return save_format::V1;
+    }
+    sqlite3 *db = nullptr;
+    if( sqlite3_open_v2( map_db_path.c_str(), &db, SQLITE_OPEN_READONLY, NULL ) != SQLITE_OK ) {
+        sqlite3_close( db );
+        return save_format::V2_COMPRESSED_SQLITE3;
+    }
+    const save_format format = read_db_save_format( db );
+    sqlite3_close( db );
+    return format;
+}
+
 save_t::save_t( const std::string &name ): name( name ) {}
 
 std::string save_t::decoded_name() const
@@ -216,9 +281,10 @@ bool WORLDINFO::save( const bool is_conversion ) const
     // We infer that the world is V2 if there's a map.sqlite3 file in the world directory.
     // When a world is freshly created, we need to create a file here to remember the users'
     // choice of world save format.
-    if( world_save_format == save_format::V2_COMPRESSED_SQLITE3 &&
+    if( save_format_uses_sqlite( world_save_format ) &&
         !file_exist( folder_path() + "/map.sqlite3" ) ) {
         sqlite3 *db = open_db( folder_path() + "/map.sqlite3" );
+        write_db_save_format( db, world_save_format );
         sqlite3_close( db );
     }
     return true;
@@ -299,21 +365,16 @@ static bool file_exist_in_db( sqlite3 *db, const std::string &path )
     return fileCount > 0;
 }
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+static void insert_into_db( sqlite3 *db, const std::string &path, compression_codec codec,
+                            const std::vector<std::byte> &compressedData )
 {
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
-
-    std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
-
+    const std::string compression = compression_codec_name( codec );
     size_t basePos = path.find_last_of( "/\\" );
     auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
 
     auto sql = R"sql(
         INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
+        VALUES (:path, :parent, :data, :compression)
         ON CONFLICT(path) DO UPDATE
             SET data = excluded.data,
                 parent = excluded.parent,
@@ -332,7 +393,11 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
         sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ||
         sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
+                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ||
+        ( compression.empty() ?
+          sqlite3_bind_null( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ) ) :
+          sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ),
+                             compression.c_str(), -1, SQLITE_TRANSIENT ) ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
         sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
@@ -344,8 +409,27 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
     sqlite3_finalize( stmt );
 }
 
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
+static void write_data_to_db( sqlite3 *db, const std::string &path, compression_codec codec,
+                              const std::string &data )
+{
+    // Reused between saves, a save writes thousands of these
+    static thread_local std::vector<std::byte> compressedData;
+    compressedData.clear();
+    compress_blob( codec, data, compressedData );
+
+    insert_into_db( db, path, codec, compressedData );
+}
+
+static void write_to_db( sqlite3 *db, const std::string &path, compression_codec codec,
+                         file_write_fn writer )
+{
+    std::ostringstream oss;
+    writer( oss );
+    write_data_to_db( db, path, codec, oss.str() );
+}
+
+static bool fetch_from_db( sqlite3 *db, const std::string &path, std::string &dataString,
+                           bool optional )
 {
     const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
 
@@ -371,20 +455,21 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
         std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
 
         if( blobData == nullptr ) {
+            sqlite3_finalize( stmt );
             return false; // Return an empty string if there's no data
         }
 
-        std::string dataString;
-        if( compression.empty() ) {
-            dataString = std::string( static_cast<const char *>( blobData ), blobSize );
-        } else if( compression == "zlib" ) {
-            zlib_decompress( blobData, blobSize, dataString );
-        } else {
+        const std::optional<compression_codec> codec = compression_codec_from_name( compression );
+        if( !codec ) {
+            sqlite3_finalize( stmt );
             throw std::runtime_error( "Unknown compression format: " + compression );
         }
-
-        std::istringstream stream( dataString );
-        reader( stream );
+        try {
+            decompress_blob( *codec, blobData, blobSize, dataString );
+        } catch( ... ) {
+            sqlite3_finalize( stmt );
+            throw;
+        }
         sqlite3_finalize( stmt );
     } else {
         auto err = sqlite3_errmsg( db );
@@ -400,25 +485,246 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
     return true;
 }
 
-static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
-                               bool optional )
+/**
+ * Whether a connection can be used from worker threads.  The workers share the connections
+ * of the main thread, which only serialized mode allows.
+ */
+static bool sqlite_is_serialized()
 {
-    return read_from_db( db, path, [&]( std::istream & fin ) {
-        JsonIn jsin( fin, path );
-        reader( jsin );
-    }, optional );
+    return sqlite3_threadsafe() == 1;
 }
 
+/**
+ * Database writes of a save transaction that finish in the background.
+ *
+ * Blobs are serialized on the main thread, because that's where the game state lives, and
+ * handed to the thread pool for compression right away.  Once the transaction is committed,
+ * a worker inserts them and commits the databases while the game goes on.  Until then, reads
+ * of queued paths are answered from memory.  Every statement on a connection that a worker may
+ * be using, including those of map quad prefetches, runs under @ref lock_db.
+ *
+ * The transaction opened by world::start_save_tx stays open until the flush commits or rolls
+ * it back, and @ref wait is the only way to know it has ended.  Any helper of the thread pool
+ * may run the flush, including the main thread while it waits on some other task.
+ */
+class save_queue
+{
+    public:
+        ~save_queue() {
+            wait();
+        }
+
+        void push( sqlite3 *db, const std::string &path, compression_codec codec, std::string &&data ) {
+            auto blob = std::make_shared<const std::string>( std::move( data ) );
+            std::future<std::vector<std::byte>> compressed = cata::get_thread_pool().submit( [blob, codec]() {
+                std::vector<std::byte> result;
+                compress_blob( codec, *blob, result );
+                return result;
+            }, cata::task_priority::low, "save_compress" );
+            index[ {db, path} ] = entries.size();
+            entries.push_back( entry{ db, path, codec, std::move( blob ), std::move( compressed ) } );
+        }
+
+        /** Uncompressed data queued for @p path, or null if there is none. */
+        const std::string *find( sqlite3 *db, const std::string &path ) {
+            collect_if_done();
+            const auto iter = index.find( { db, path } );
+            return iter == index.end() ? nullptr : entries[iter->second].data.get();
+        }
+
+        bool empty() const {
+            return entries.empty();
+        }
+
+        /** Insert the queued blobs and commit @p tx_dbs on a worker thread. */
+        void flush_async( std::vector<sqlite3 *> tx_dbs ) {
+            flush = cata::get_thread_pool().submit( [this, tx_dbs = std::move( tx_dbs )]() {
+                try {
+                    for( entry &e : entries ) {
+                        cata::get_thread_pool().help_until_ready( e.compressed );
+                        const std::vector<std::byte> compressed = e.compressed.get();
+                        std::lock_guard<std::mutex> lock( db_mutex );
+                        insert_into_db( e.db, e.path, e.codec, compressed );
+                    }
+                } catch( ... ) {
+                    std::lock_guard<std::mutex> lock( db_mutex );
+                    for( sqlite3 *db : tx_dbs ) {
+                        sqlite3_exec( db, "ROLLBACK", NULL, NULL, NULL );
+                    }
+                    throw;
+                }
+                std::lock_guard<std::mutex> lock( db_mutex );
+                for( sqlite3 *db : tx_dbs ) {
+                    sqlite3_exec( db, "COMMIT", NULL, NULL, NULL );
+                }
+            }, cata::task_priority::low, "save_flush" );
+        }
+
+        /** Block until the queued blobs are stored, then forget them. */
+        void wait() {
+            if( flush.valid() ) {
+                cata::get_thread_pool().help_until_ready( flush );
+                finish();
+            } else if( !entries.empty() ) {
+                // Transaction was never committed, don't leave compression tasks referring to us.
+                for( entry &e : entries ) {
+                    cata::get_thread_pool().help_until_ready( e.compressed );
+                }
+                entries.clear();
+                index.clear();
+            }
+        }
+
+        /** Lock held while using a database that a flush may be writing to. */
+        std::unique_lock<std::mutex> lock_db() {
+            return std::unique_lock<std::mutex>( db_mutex );
+        }
+
+    private:
+        struct entry {
+            sqlite3 *db;
+            std::string path;
+            compression_codec codec;
+            std::shared_ptr<const std::string> data;
+            std::future<std::vector<std::byte>> compressed;
+        };
+
+        void collect_if_done() {
+            if( flush.valid() && flush.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+                finish();
+            }
+        }
+
+        void finish() {
+            entries.clear();
+            index.clear();
+            try {
+                flush.get();
+            } catch( const std::exception &err ) {
+                debugmsg( "Failed to write save data: %s", err.what() );
+            }
+        }
+
+        std::vector<entry> entries;
+        std::map<std::pair<sqlite3 *, std::string>, size_t> index;
+        std::future<void> flush;
+        std::mutex db_mutex;
+};
+
+/**
+ * Map quads read ahead of time on the thread pool.
+ *
+ * Only the reading and decompression happen in the background.  Parsing creates items and
+ * vehicles, which is not safe off the main thread, so it is left to the reader of the quad.
+ */
+class map_quad_prefetcher
+{
+    public:
+        using result_t = std::optional<std::string>;
+
+        ~map_quad_prefetcher() {
+            clear();
+        }
+
+        bool contains( const tripoint &om_addr ) const {
+            return entries.contains( om_addr );
+        }
+
+        void start( const tripoint &om_addr, std::function<result_t()> read ) {
+            collect_abandoned();
+            while( entries.size() >= max_entries && !order.empty() ) {
+                drop( order.front() );
+                order.pop_front();
+            }
+            cata::cancellation_token token;
+            std::future<result_t> data = cata::get_thread_pool().submit( std::move( read ),
+                                         cata::task_priority::low, "map_quad_prefetch", token );
+            entries.emplace( om_addr, entry{ std::move( data ), token } );
+            order.push_back( om_addr );
+            if( order.size() > 2 * max_entries ) {
+                std::erase_if( order, [this]( const tripoint & p ) {
+                    return !entries.contains( p );
+                } );
+            }
+        }
+
+        /**
+         * Result of the read of @p om_addr, waiting for it if it's still in progress.
+         * Empty if the quad was not prefetched or the read failed, in which case
+         * it has to be read directly.
+         */
+        std::optional<result_t> take( const tripoint &om_addr ) {
+            const auto iter = entries.find( om_addr );
+            if( iter == entries.end() ) {
+                return std::nullopt;
+            }
+            std::future<result_t> data = std::move( iter->second.data );
+            entries.erase( iter );
+            cata::get_thread_pool().help_until_ready( data );
+            try {
+                return data.get();
+            } catch( const std::exception & ) {
+                return std::nullopt;
+            }
+        }
+
+        /** Forget about @p om_addr, e.g. because the stored quad changed. */
+        void drop( const tripoint &om_addr ) {
+            const auto iter = entries.find( om_addr );
+            if( iter == entries.end() ) {
+                return;
+            }
+            iter->second.token.cancel();
+            abandoned.push_back( std::move( iter->second.data ) );
+            entries.erase( iter );
+        }
+
+        /** Drop everything and wait for reads that are in progress. */
+        void clear() {
+            for( auto &elem : entries ) {
+                elem.second.token.cancel();
+                abandoned.push_back( std::move( elem.second.data ) );
+            }
+            entries.clear();
+            order.clear();
+            for( std::future<result_t> &data : abandoned ) {
+                cata::get_thread_pool().help_until_ready( data );
+            }
+            abandoned.clear();
+        }
+
+    private:
+        struct entry {
+            std::future<result_t> data;
+            cata::cancellation_token token;
+        };
+
+        void collect_abandoned() {
+            std::erase_if( abandoned, []( const std::future<result_t> &data ) {
+                return data.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+            } );
+        }
+
+        static constexpr size_t max_entries = world::max_prefetched_map_quads;
+        std::map<tripoint, entry> entries;
+        std::deque<tripoint> order;
+        // Reads that nobody is interested in anymore, but that may still use the world
+        std::vector<std::future<result_t>> abandoned;
+};
+
 world::world( WORLDINFO *info )
     : info( info )
     , save_tx_start_ts( 0 )
+    , pending_save( std::make_unique<save_queue>() )
+    , quad_prefetcher( std::make_unique<map_quad_prefetcher>() )
 {
     if( !assure_dir_exist( "" ) ) {
         dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
     }
 
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
         map_db = open_db( info->folder_path() + "/map.sqlite3" );
+        write_db_save_format( map_db, info->world_save_format );
     } else {
         if( !assure_dir_exist( "/maps" ) ) {
             dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -428,6 +734,9 @@ world::world( WORLDINFO *info )
 
 world::~world()
 {
+    quad_prefetcher->clear();
+    pending_save->wait();
+
     if( save_tx_start_ts != 0 ) {
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
@@ -446,10 +755,14 @@ void world::start_save_tx()
     if( save_tx_start_ts != 0 ) {
         throw std::runtime_error( "Attempted to start a save transaction while one was already in progress" );
     }
+    // Writes of the previous save have to land before this one starts its transaction
+    pending_save->wait();
+    async_save_tx = get_option<bool>( "ASYNC_SAVE" ) && sqlite_is_serialized();
     save_tx_start_ts = std::chrono::duration_cast< std::chrono::milliseconds >(
                            std::chrono::system_clock::now().time_since_epoch()
                        ).count();
 
+    auto lock = pending_save->lock_db();
     if( map_db ) {
         sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
@@ -465,13 +778,26 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
-    if( map_db ) {
-        sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
-    }
+    if( !pending_save->empty() ) {
+        std::vector<sqlite3 *> tx_dbs;
+        if( map_db ) {
+            tx_dbs.push_back( map_db );
+        }
+        if( save_db ) {
+            tx_dbs.push_back( save_db );
+        }
+        pending_save->flush_async( std::move( tx_dbs ) );
+    } else {
+        auto lock = pending_save->lock_db();
+        if( map_db ) {
+            sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
+        }
 
-    if( save_db ) {
-        sqlite3_exec( save_db, "COMMIT", NULL, NULL, NULL );
+        if( save_db ) {
+            sqlite3_exec( save_db, "COMMIT", NULL, NULL, NULL );
+        }
     }
+    async_save_tx = false;
 
     int64_t now = std::chrono::duration_cast< std::chrono::milliseconds >(
                       std::chrono::system_clock::now().time_since_epoch()
@@ -481,6 +807,90 @@ int64_t world::commit_save_tx()
     return duration;
 }
 
+/**
+ * DATABASE ACCESS
+ */
+
+bool world::file_exist_db( sqlite3 *db, const std::string &path ) const
+{
+    if( pending_save->find( db, path ) != nullptr ) {
+        return true;
+    }
+    auto lock = pending_save->lock_db();
+    return file_exist_in_db( db, path );
+}
+
+bool world::read_db_data( sqlite3 *db, const std::string &path, std::string &data,
+                          bool optional ) const
+{
+    if( const std::string *pending = pending_save->find( db, path ) ) {
+        data = *pending;
+        return true;
+    }
+    auto lock = pending_save->lock_db();
+    return fetch_from_db( db, path, data, optional );
+}
+
+bool world::read_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                     bool optional ) const
+{
+    std::string data;
+    if( !read_db_data( db, path, data, optional ) ) {
+        return false;
+    }
+    std::istringstream stream( std::move( data ) );
+    reader( stream );
+    return true;
+}
+
+bool world::read_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
+                          bool optional ) const
+{
+    std::string data;
+    if( !read_db_data( db, path, data, optional ) ) {
+        return false;
+    }
+    JsonIn jsin( data, path );
+    reader( jsin );
+    return true;
+}
+
+void world::write_db( sqlite3 *db, const std::string &path, file_write_fn writer ) const
+{
+    if( save_tx_start_ts != 0 && async_save_tx ) {
+        std::ostringstream oss;
+        writer( oss );
+        pending_save->push( db, path, save_format_codec( info->world_save_format ),
+                            std::move( oss ).str() );
+        return;
+    }
+    // Must not be overwritten by an older copy from the previous save that is still being stored
+    pending_save->wait();
+    std::ostringstream oss;
+    writer( oss );
+    auto lock = pending_save->lock_db();
+    write_data_to_db( db, path, save_format_codec( info->world_save_format ), oss.str() );
+}
+
+void world::write_db_json( sqlite3 *db, const std::string &path, file_write_json_fn writer ) const
+{
+    const compression_codec codec = save_format_codec( info->world_save_format );
+    if( save_tx_start_ts != 0 && async_save_tx ) {
+        std::string data;
+        JsonOut jsout( data );
+        writer( jsout );
+        pending_save->push( db, path, codec, std::move( data ) );
+        return;
+    }
+    pending_save->wait();
+    static thread_local std::string data;
+    data.clear();
+    JsonOut jsout( data );
+    writer( jsout );
+    auto lock = pending_save->lock_db();
+    write_data_to_db( db, path, codec, data );
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -496,43 +906,106 @@ static std::string get_quad_filename( const tripoint &om_addr )
     return string_format( "%d.%d.%d.map", om_addr.x, om_addr.y, om_addr.z );
 }
 
-bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+std::string world::get_map_quad_path( const tripoint &om_addr ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
 
-    // V2 logic
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
-    } else {
-        if( !file_exist( quad_path ) ) {
-            // Fix for old saves where the path was generated using std::stringstream, which
-            // did format the number using the current locale. That formatting may insert
-            // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-            // of "map/1234.7.8.map".
-            std::ostringstream buffer;
-            buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-            if( file_exist( buffer.str() ) ) {
-                quad_path = buffer.str();
-            }
+    if( !save_format_uses_sqlite( info->world_save_format ) && !file_exist( quad_path ) ) {
+        // Fix for old saves where the path was generated using std::stringstream, which
+        // did format the number using the current locale. That formatting may insert
+        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+        // of "map/1234.7.8.map".
+        std::ostringstream buffer;
+        buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+        if( file_exist( buffer.str() ) ) {
+            quad_path = buffer.str();
         }
+    }
+    return quad_path;
+}
 
+bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+{
+    const std::string quad_path = get_map_quad_path( om_addr );
+
+    if( std::optional<map_quad_prefetcher::result_t> prefetched = quad_prefetcher->take( om_addr ) ) {
+        if( !*prefetched ) {
+            return false;
+        }
+        JsonIn jsin( **prefetched, quad_path );
+        reader( jsin );
+        return true;
+    }
+
+    // V2 logic
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
+        return read_db_json( map_db, quad_path, reader, true );
+    } else {
         return read_from_file_json( quad_path, reader, true );
     }
 }
 
-bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) const
+void world::prefetch_map_quads( const std::vector<tripoint> &om_addrs ) const
+{
+    const bool sqlite = save_format_uses_sqlite( info->world_save_format );
+    if( sqlite && !sqlite_is_serialized() ) {
+        return;
+    }
+    for( const tripoint &om_addr : om_addrs ) {
+        if( quad_prefetcher->contains( om_addr ) ) {
+            continue;
+        }
+        const std::string quad_path = get_map_quad_path( om_addr );
+        // Not stored yet, the database has an outdated copy
+        if( sqlite && pending_save->find( map_db, quad_path ) != nullptr ) {
+            continue;
+        }
+        quad_prefetcher->start( om_addr, [this, sqlite, quad_path]() -> map_quad_prefetcher::result_t {
+            std::string data;
+            if( sqlite ) {
+                auto lock = pending_save->lock_db();
+                if( !fetch_from_db( map_db, quad_path, data, true ) ) {
+                    return std::nullopt;
+                }
+                return data;
+            }
+            const std::string path = info->folder_path() + "/" + quad_path;
+            if( !::file_exist( path ) ) {
+                return std::nullopt;
+            }
+            cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( path ) );
+            if( !fin.is_open() ) {
+                throw std::runtime_error( "opening file failed" );
+            }
+            data.assign( std::istreambuf_iterator<char>( *fin ), std::istreambuf_iterator<char>() );
+            if( fin.bad() ) {
+                throw std::runtime_error( "reading file failed" );
+            }
+            return data;
+        } );
+    }
+}
+
+bool world::write_map_quad( const tripoint &om_addr, file_write_json_fn writer ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
+    quad_prefetcher->drop( om_addr );
 
     // V2 logic
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, quad_path, writer );
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
+        write_db_json( map_db, quad_path, writer );
         return true;
     } else {
         assure_dir_exist( dirname );
-        return write_to_file( quad_path, writer );
+        static thread_local std::string data;
+        data.clear();
+        JsonOut jsout( data );
+        writer( jsout );
+        return write_to_file( quad_path, [&]( std::ostream & fout ) {
+            fout.write( data.data(), data.size() );
+        } );
     }
 }
 
@@ -552,8 +1025,8 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 
 bool world::overmap_exists( const point_abs_om &p ) const
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
+        return file_exist_db( map_db, overmap_terrain_filename( p ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
     }
@@ -561,8 +1034,8 @@ bool world::overmap_exists( const point_abs_om &p ) const
 
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
+        return read_db( map_db, overmap_terrain_filename( p ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
     }
@@ -570,9 +1043,9 @@ bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 
 bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn reader )
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
         sqlite3 *playerdb = get_player_db();
-        return read_from_db( playerdb, overmap_player_filename( p ), reader, true );
+        return read_db( playerdb, overmap_player_filename( p ), reader, true );
     } else {
         return read_from_player_file( overmap_player_filename( p ), reader, true );
     }
@@ -580,8 +1053,8 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 
 bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, overmap_terrain_filename( p ), writer );
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
+        write_db( map_db, overmap_terrain_filename( p ), writer );
         return true;
     } else {
         return write_to_file( overmap_terrain_filename( p ), writer );
@@ -590,9 +1063,9 @@ bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 
 bool world::write_overmap_player_visibility( const point_abs_om &p, file_write_fn writer )
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, overmap_player_filename( p ), writer );
+        write_db( playerdb, overmap_player_filename( p ), writer );
         return true;
     } else {
         return write_to_player_file( overmap_player_filename( p ), writer );
@@ -609,9 +1082,9 @@ static std::string get_mm_filename( const tripoint &p )
 
 bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
         sqlite3 *playerdb = get_player_db();
-        return read_from_db_json( playerdb, get_mm_filename( p ), reader, true );
+        return read_db_json( playerdb, get_mm_filename( p ), reader, true );
     } else {
         return read_from_player_file_json( ".mm1/" + get_mm_filename( p ), reader, true );
     }
@@ -619,9 +1092,9 @@ bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 
 bool world::write_player_mm_quad( const tripoint &p, file_write_fn writer )
 {
-    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+    if( save_format_uses_sqlite( info->world_save_format ) ) {
         sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, get_mm_filename( p ), writer );
+        write_db( playerdb, get_mm_filename( p ), writer );
         return true;
     } else {
         const std::string descr = string_format(
@@ -723,6 +1196,66 @@ static void replaceBackslashes( std::string &input )
 /**
  * Save Conversion
  */
+static void recompress_db( sqlite3 *db, compression_codec codec )
+{
+    const std::string target = compression_codec_name( codec );
+    std::vector<std::string> paths;
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "SELECT path FROM files WHERE IFNULL(compression, '') != :compression",
+                            -1, &stmt, nullptr ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ), target.c_str(), -1,
+                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        sqlite3_finalize( stmt );
+        throw std::runtime_error( "DB query failed" );
+    }
+    while( sqlite3_step( stmt ) == SQLITE_ROW ) {
+        paths.emplace_back( reinterpret_cast<const char *>( sqlite3_column_text( stmt, 0 ) ) );
+    }
+    sqlite3_finalize( stmt );
+
+    // Every blob records its own codec, so a conversion that gets interrupted
+    // leaves a database that is still readable.
+    sqlite3_exec( db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+    for( const std::string &path : paths ) {
+        std::string data;
+        if( !fetch_from_db( db, path, data, false ) ) {
+            continue;
+        }
+        std::vector<std::byte> compressed;
+        compress_blob( codec, data, compressed );
+        insert_into_db( db, path, codec, compressed );
+    }
+    sqlite3_exec( db, "COMMIT", NULL, NULL, NULL );
+}
+
+void world::convert_save_format( save_format target )
+{
+    if( !save_format_uses_sqlite( info->world_save_format ) || !save_format_uses_sqlite( target ) ) {
+        throw std::runtime_error( "Only worlds stored in SQLite can change their compression" );
+    }
+    dbg( DL::Info ) << "Recompressing world '" << info->world_name << "' with " <<
+                    compression_codec_name( save_format_codec( target ) );
+    quad_prefetcher->clear();
+    pending_save->wait();
+    auto lock = pending_save->lock_db();
+
+    const compression_codec codec = save_format_codec( target );
+    for( const std::string &db_path : get_files_from_path( ".sqlite3", info->folder_path(), false,
+            true ) ) {
+        const size_t name_pos = db_path.find_last_of( "/\\" );
+        if( db_path.substr( name_pos == std::string::npos ? 0 : name_pos + 1 ) == "map.sqlite3" ) {
+            continue;
+        }
+        sqlite3 *player_db = open_db( db_path );
+        recompress_db( player_db, codec );
+        sqlite3_close( player_db );
+    }
+    recompress_db( map_db, codec );
+
+    info->world_save_format = target;
+    write_db_save_format( map_db, target );
+}
 void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
 {
     dbg( DL::Info ) << "Converting world '" << info->world_name << "' from v1 to v2 format";
@@ -730,7 +1263,9 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
     // The map database should already be loaded via the constructor.
     // The save database(s) will need to be created separately here.
     // Transactions are mostly being used for performance reasons rather than consistency.
+    auto lock = pending_save->lock_db();
     sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+    const compression_codec codec = save_format_codec( info->world_save_format );
 
     // Keep track of the last used save DB
     sqlite3 *last_save_db = nullptr;
@@ -757,7 +1292,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
                     continue;
                 }
                 ::read_from_file( subpath, [&]( std::istream & fin ) {
-                    write_to_db( map_db, map_path, [&]( std::ostream & fout ) {
+                    write_to_db( map_db, map_path, codec, [&]( std::ostream & fout ) {
                         fout << fin.rdbuf();
                     } );
                 } );
@@ -768,7 +1303,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
         // Migrate o.* files into the map database
         if( part.starts_with( "o." ) ) {
             ::read_from_file( file_path, [&]( std::istream & fin ) {
-                write_to_db( map_db, part, [&]( std::ostream & fout ) {
+                write_to_db( map_db, part, codec, [&]( std::ostream & fout ) {
                     fout << fin.rdbuf();
                 } );
             } );
@@ -790,7 +1325,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
 
             if( part.find( ".seen." ) != std::string::npos ) {
                 ::read_from_file( file_path, [&]( std::istream & fin ) {
-                    write_to_db( last_save_db, part.substr( save_id.size() ), [&]( std::ostream & fout ) {
+                    write_to_db( last_save_db, part.substr( save_id.size() ), codec, [&]( std::ostream & fout ) {
                         fout << fin.rdbuf();
                     } );
                 } );
@@ -804,7 +1339,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
                         continue;
                     }
                     ::read_from_file( subpath, [&]( std::istream & fin ) {
-                        write_to_db( last_save_db, map_path, [&]( std::ostream & fout ) {
+                        write_to_db( last_save_db, map_path, codec, [&]( std::ostream & fout ) {
                             fout << fin.rdbuf();
                         } );
                     } );
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
+#include "compress.h"
 #include "json.h"
 #include "options.h"
 #include "type_id.h"
@@ -9,6 +11,8 @@
 #include "fstream_utils.h"
 
 class avatar;
+class map_quad_prefetcher;
+class save_queue;
 class sqlite3;
 
 class save_t
@@ -41,8 +45,18 @@ enum save_format : int {
 
     /** V2 format - compressed tuples in SQLite3 */
     V2_COMPRESSED_SQLITE3 = 1,
+
+    /** V2 layout, compressed with LZ4 instead of zlib for faster loading and saving */
+    V2_LZ4_SQLITE3 = 2,
 };
 
+/** Whether worlds in @p format keep their data in SQLite databases. */
+bool save_format_uses_sqlite( save_format format );
+/** Codec used for data written to worlds in @p format. */
+compression_codec save_format_codec( save_format format );
+/** Format of the world stored in @p world_path. */
+save_format detect_save_format( const std::string &world_path );
+
 /**
  * Structure containing metadata about a world. No actual world data is processed here.
  *
@@ -99,6 +113,15 @@ class world
          *
          * When using the V1 non-sqlite save system, this merely records some metadata
          * so we can print how long the save took.
+         *
+         * With the V2 format and the ASYNC_SAVE option, blobs written during a transaction
+         * are only serialized on the calling thread. Compression, storing and the final commit
+         * happen on the thread pool, so commit_save_tx returns before the data is on disk and
+         * the SQLite transaction stays open until the flush commits it. Reads of data that is
+         * still on its way are answered from memory. The flush is an ordinary pool task, so a
+         * main thread waiting on other tasks may end up running it. If the game dies before
+         * the flush commits, the transaction is rolled back and the whole save is lost, the
+         * previous save stays intact.
          */
         /**@{*/
         void start_save_tx();
@@ -111,7 +134,15 @@ class world
          * scattering it throughout the codebase.
          */
         bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
-        bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
+        bool write_map_quad( const tripoint &om_addr, file_write_json_fn writer ) const;
+        /**
+         * Start reading the given map quads in the background, so that a later
+         * @ref read_map_quad of one of them only has to parse it.
+         * Reads requested earliest are dropped first once more than
+         * @ref max_prefetched_map_quads are kept.
+         */
+        void prefetch_map_quads( const std::vector<tripoint> &om_addrs ) const;
+        static constexpr size_t max_prefetched_map_quads = 256;
 
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
@@ -165,9 +196,33 @@ class world
          */
         void convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world );
 
+        /**
+         * Recompress all data of a SQLite world with the codec of @p target, in place.
+         * Only switches between formats that are stored in SQLite.
+         */
+        void convert_save_format( save_format target );
+
     private:
         /** If non-zero, indicates we're in the middle of a save event */
         int64_t save_tx_start_ts = 0;
+        /** Whether writes of the current save transaction are stored in the background */
+        bool async_save_tx = false;
+        /** Writes of the last save transaction that are still being stored */
+        std::unique_ptr<save_queue> pending_save;
+        /** Map quads read ahead of time by @ref prefetch_map_quads */
+        std::unique_ptr<map_quad_prefetcher> quad_prefetcher;
+
+        std::string get_map_quad_path( const tripoint &om_addr ) const;
+
+        bool file_exist_db( sqlite3 *db, const std::string &path ) const;
+        /** Contents of @p path, from a pending save if there is one. */
+        bool read_db_data( sqlite3 *db, const std::string &path, std::string &data, bool optional ) const;
+        bool read_db( sqlite3 *db, const std::string &path, file_read_fn reader, bool optional ) const;
+        bool read_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
+                           bool optional ) const;
+        void write_db( sqlite3 *db, const std::string &path, file_write_fn writer ) const;
+        /** Like @ref write_db, but serializes into a string instead of a stream. */
+        void write_db_json( sqlite3 *db, const std::string &path, file_write_json_fn writer ) const;
 
         std::string overmap_terrain_filename( const point_abs_om &p ) const;
         std::string overmap_player_filename( const point_abs_om &p ) const;
@@ -196,12 +196,9 @@ void worldfactory::init()
         all_worlds[worldname] = std::make_unique<WORLDINFO>();
         // give the world a name
         all_worlds[worldname]->world_name = worldname;
-        // Record the world save format. V2 is identified by the presence of a map.sqlite3 file.
-        if( file_exist( world_dir + "/map.sqlite3" ) ) {
-            all_worlds[worldname]->world_save_format = save_format::V2_COMPRESSED_SQLITE3;
-        } else {
-            all_worlds[worldname]->world_save_format = save_format::V1;
-        }
+        // Record the world save format. V2 is identified by the presence of a map.sqlite3 file,
+        // which also records the codec.
+        all_worlds[worldname]->world_save_format = detect_save_format( world_dir );
         // add sav files
         for( auto &world_sav_file : world_sav_files ) {
             all_worlds[worldname]->world_saves.push_back( save_t::from_base_path( world_sav_file ) );
@@ -1330,9 +1327,12 @@ int worldfactory::show_worldgen_tab_confirm( const catacurses::window &win, WORL
                         _( "Press [<color_yellow>%s</color>] to pick a random name for your world." ),
                         ctxt.get_desc( "PICK_RANDOM_WORLDNAME" ) );
 
-        if( world->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        if( world->world_save_format == save_format::V2_LZ4_SQLITE3 ) {
             mvwprintz( w_confirmation, point( 2, 6 ), c_cyan,
-                       _( "Save Format: Experimental V2 save format" ) );
+                       _( "Save Format: Experimental V2 save format (fast compression)" ) );
+        } else if( world->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+            mvwprintz( w_confirmation, point( 2, 6 ), c_cyan,
+                       _( "Save Format: Experimental V2 save format (small compression)" ) );
         } else {
             mvwprintz( w_confirmation, point( 2, 6 ), c_white,
                        _( "Save Format: Standard (V1) save format" ) );
@@ -1395,6 +1395,8 @@ int worldfactory::show_worldgen_tab_confirm( const catacurses::window &win, WORL
             world->world_name = worldname = pick_random_name();
         } else if( action == "TOGGLE_V2_SAVE_FORMAT" ) {
             if( world->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+                world->world_save_format = save_format::V2_LZ4_SQLITE3;
+            } else if( world->world_save_format == save_format::V2_LZ4_SQLITE3 ) {
                 world->world_save_format = save_format::V1;
             } else {
                 world->world_save_format = save_format::V2_COMPRESSED_SQLITE3;
@@ -1653,4 +1655,48 @@ void worldfactory::convert_to_v2( const std::string &worldname )
     worldinfo->save();
 
     popup( _( "Conversion Complete!" ) );
-}
\ No newline at end of file
+}
+
+void worldfactory::convert_to_lz4( const std::string &worldname )
+{
+    WORLDINFO *worldinfo = get_world( worldname );
+    if( worldinfo == nullptr ) {
+        popup( _( "Tried to convert non-existing world %s" ), worldname );
+        return;
+    }
+
+    if( worldinfo->world_save_format == save_format::V1 ) {
+        popup( _( "World %s needs to be converted to the V2 save format first" ), worldname );
+        return;
+    }
+
+    if( worldinfo->world_save_format == save_format::V2_LZ4_SQLITE3 ) {
+        popup( _( "World %s already uses fast compression" ), worldname );
+        return;
+    }
+
+    const save_format old_format = worldinfo->world_save_format;
+    // The databases are rewritten in place, keep copies to go back to
+    const std::vector<std::string> db_paths = get_files_from_path( ".sqlite3",
+            worldinfo->folder_path(), false, true );
+    for( const std::string &db_path : db_paths ) {
+        if( !copy_file( db_path, db_path + ".bak" ) ) {
+            popup( _( "Failed to back up %s, aborting conversion" ), db_path );
+            return;
+        }
+    }
+
+    try {
+        world converted( worldinfo );
+        converted.convert_save_format( save_format::V2_LZ4_SQLITE3 );
+    } catch( const std::exception &err ) {
+        for( const std::string &db_path : db_paths ) {
+            rename_file( db_path + ".bak", db_path );
+        }
+        worldinfo->world_save_format = old_format;
+        popup( _( "Failed to convert world %s, the old save was restored: %s" ), worldname, err.what() );
+        return;
+    }
+
+    popup( _( "Conversion Complete!  The old save databases were kept as .sqlite3.bak files." ) );
+}
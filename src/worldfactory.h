@@ -78,6 +78,8 @@ class worldfactory
         void edit_active_world_mods( WORLDINFO *world );
 
         void convert_to_v2( const std::string &worldname );
+        /** Recompress a V2 world with LZ4, in place. The old databases are kept as backups. */
+        void convert_to_lz4( const std::string &worldname );
 
     private:
         std::map<std::string, std::unique_ptr<WORLDINFO>> all_worlds;
@@ -0,0 +1,109 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+
+#include "clock_cache.h"
+#include "lru_cache.h"
+#include "point.h"
+#include "string_formatter.h"
+
+TEST_CASE( "clock_cache_stores_and_overwrites", "[clock_cache]" )
+{
+    clock_cache<tripoint, int> cache;
+    CHECK( cache.get( tripoint_zero, -1 ) == -1 );
+    cache.insert( 10, tripoint_zero, 1 );
+    cache.insert( 10, tripoint_east, 2 );
+    cache.insert( 10, tripoint_east, 3 );
+    CHECK( cache.size() == 2 );
+    CHECK( cache.get( tripoint_zero, -1 ) == 1 );
+    CHECK( cache.get( tripoint_east, -1 ) == 3 );
+
+    cache.remove( tripoint_zero );
+    CHECK( cache.size() == 1 );
+    CHECK( cache.get( tripoint_zero, -1 ) == -1 );
+    CHECK( cache.get( tripoint_east, -1 ) == 3 );
+
+    cache.clear();
+    CHECK( cache.size() == 0 );
+    CHECK( cache.get( tripoint_east, -1 ) == -1 );
+
+    const cache_stats &stats = cache.get_stats();
+    CHECK( stats.hits == 3 );
+    CHECK( stats.misses == 3 );
+    CHECK( stats.evictions == 0 );
+}
+
+TEST_CASE( "clock_cache_evicts_unused_entries_first", "[clock_cache]" )
+{
+    constexpr int limit = 64;
+    clock_cache<point, char> cache;
+    for( int i = 0; i < limit; i++ ) {
+        cache.insert( limit, point( i, 0 ), 1 );
+    }
+    // Keep reading the first half, the second half should be evicted instead
+    for( int i = 0; i < limit; i++ ) {
+        for( int j = 0; j < limit / 2; j++ ) {
+            REQUIRE( cache.get( point( j, 0 ), 0 ) == 1 );
+        }
+        cache.insert( limit, point( i, 1 ), 1 );
+        CHECK( cache.size() == static_cast<size_t>( limit ) );
+    }
+    for( int j = 0; j < limit / 2; j++ ) {
+        CHECK( cache.get( point( j, 0 ), 0 ) == 1 );
+    }
+    CHECK( cache.get( point( limit - 1, 1 ), 0 ) == 1 );
+    CHECK( cache.get_stats().evictions == static_cast<uint64_t>( limit ) );
+}
+
+TEST_CASE( "clock_cache_survives_churn", "[clock_cache]" )
+{
+    constexpr int limit = 100;
+    clock_cache<tripoint, int> cache;
+    for( int i = 0; i < 10000; i++ ) {
+        const tripoint p( i % 337, i % 113, 0 );
+        cache.insert( limit, p, i );
+        REQUIRE( cache.get( p, -1 ) == i );
+        if( i % 7 == 0 ) {
+            cache.remove( tripoint( ( i / 2 ) % 337, ( i / 2 ) % 113, 0 ) );
+        }
+        REQUIRE( cache.size() <= static_cast<size_t>( limit ) );
+    }
+    // A different limit drops everything
+    cache.insert( limit / 2, tripoint_zero, 5 );
+    CHECK( cache.size() == 1 );
+    CHECK( cache.get( tripoint_zero, -1 ) == 5 );
+}
+
+// Mimics map::sees filling skew_vision_cache: lookups first, insert on a miss
+template<typename Cache>
+static long long time_vision_lookups( Cache &cache, int limit )
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int turn = 0; turn < 20; turn++ ) {
+        for( int x = 0; x < 300; x++ ) {
+            for( int y = 0; y < 300; y++ ) {
+                const point key( x + turn * 5, y );
+                if( cache.get( key, -1 ) == -1 ) {
+                    cache.insert( limit, key, 1 );
+                }
+            }
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+}
+
+TEST_CASE( "clock_cache_perf", "[.][benchmark]" )
+{
+    constexpr int limit = 100000;
+    lru_cache<point, char> lru;
+    clock_cache<point, char> clock;
+    const long long lru_time = time_vision_lookups( lru, limit );
+    const long long clock_time = time_vision_lookups( clock, limit );
+    const cache_stats &stats = clock.get_stats();
+    cata_printf( "lru_cache:   %lld microseconds.\n", lru_time );
+    cata_printf( "clock_cache: %lld microseconds, %llu hits, %llu misses, %llu evictions.\n",
+                 clock_time, static_cast<unsigned long long>( stats.hits ),
+                 static_cast<unsigned long long>( stats.misses ),
+                 static_cast<unsigned long long>( stats.evictions ) );
+}
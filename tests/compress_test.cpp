@@ -0,0 +1,101 @@
+#include "catch/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "compress.h"
+#include "rng.h"
+
+static std::string round_trip( compression_codec codec, const std::string &input )
+{
+    std::vector<std::byte> compressed;
+    compress_blob( codec, input, compressed );
+    std::string output;
+    decompress_blob( codec, compressed.data(), compressed.size(), output );
+    return output;
+}
+
+TEST_CASE( "compression_codecs_round_trip", "[compress]" )
+{
+    const compression_codec codec = GENERATE( compression_codec::none, compression_codec::zlib,
+                                    compression_codec::lz4 );
+    CAPTURE( compression_codec_name( codec ) );
+
+    CHECK( compression_codec_from_name( compression_codec_name( codec ) ) == codec );
+
+    SECTION( "empty" ) {
+        CHECK( round_trip( codec, "" ).empty() );
+    }
+    SECTION( "shorter than a match" ) {
+        CHECK( round_trip( codec, "abc" ) == "abc" );
+    }
+    SECTION( "long runs and overlapping matches" ) {
+        const std::string input = std::string( 1000, 'a' ) + "b" + std::string( 70000, 'c' );
+        CHECK( round_trip( codec, input ) == input );
+    }
+    SECTION( "json-like data" ) {
+        std::string input;
+        for( int i = 0; i < 2000; i++ ) {
+            input += "{\"id\":\"submap\",\"x\":" + std::to_string( rng( 0, 11 ) ) + ",\"y\":" +
+                     std::to_string( rng( 0, 11 ) ) + "},";
+        }
+        CHECK( round_trip( codec, input ) == input );
+    }
+    SECTION( "incompressible data" ) {
+        std::string input;
+        for( int i = 0; i < 5000; i++ ) {
+            input += static_cast<char>( rng( 0, 255 ) );
+        }
+        CHECK( round_trip( codec, input ) == input );
+    }
+}
+
+TEST_CASE( "lz4_decodes_blocks_of_the_reference_library", "[compress]" )
+{
+    std::string input = "0123456789abcdefghijklmnopqrstuvwxyz";
+    for( int i = 0; i < 40; i++ ) {
+        input += "{\"id\":\"t_floor\",\"x\":3},";
+    }
+    input += std::string( 300, 'z' ) + "end of the reference block";
+    REQUIRE( input.size() == 1282 );
+
+    // LZ4_compress_default of liblz4 1.9.4, after the 32 bit length the game stores first
+    const std::vector<unsigned char> reference = {
+        0x02, 0x05, 0x00, 0x00,
+        0xff, 0x2c, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+        0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c,
+        0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78,
+        0x79, 0x7a, 0x7b, 0x22, 0x69, 0x64, 0x22, 0x3a, 0x22, 0x74, 0x5f, 0x66,
+        0x6c, 0x6f, 0x6f, 0x72, 0x22, 0x2c, 0x22, 0x78, 0x22, 0x3a, 0x33, 0x7d,
+        0x2c, 0x17, 0x00, 0xff, 0xff, 0xff, 0x71, 0x1f, 0x7a, 0x01, 0x00, 0xff,
+        0x19, 0xf0, 0x0b, 0x65, 0x6e, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68,
+        0x65, 0x20, 0x72, 0x65, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 0x20,
+        0x62, 0x6c, 0x6f, 0x63, 0x6b
+    };
+    std::string output;
+    lz4_decompress( reference.data(), reference.size(), output );
+    CHECK( output == input );
+}
+
+TEST_CASE( "lz4_rejects_corrupted_blobs", "[compress]" )
+{
+    const std::string input = std::string( 300, 'x' ) + "tail of the blob";
+    std::vector<std::byte> compressed;
+    lz4_compress( input, compressed );
+    std::string output;
+
+    SECTION( "truncated" ) {
+        CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size() - 3, output ) );
+    }
+    SECTION( "wrong stored length" ) {
+        compressed[0] = static_cast<std::byte>( static_cast<unsigned char>( compressed[0] ) + 1 );
+        CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size(), output ) );
+    }
+    SECTION( "stored length beyond what the block can hold" ) {
+        for( size_t i = 0; i < 4; i++ ) {
+            compressed[i] = static_cast<std::byte>( 0xFF );
+        }
+        CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size(), output ) );
+        CHECK( output.empty() );
+    }
+}
@@ -0,0 +1,69 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "creature_tracker.h"
+#include "memory_fast.h"
+#include "monster.h"
+#include "point.h"
+#include "type_id.h"
+
+static monster *add_monster( Creature_tracker &tracker, const std::string &id, const tripoint &p )
+{
+    const shared_ptr_fast<monster> critter = make_shared_fast<monster>( mtype_id( id ), p );
+    REQUIRE( tracker.add( critter ) );
+    return critter.get();
+}
+
+static bool contains( const std::vector<monster *> &found, const monster *critter )
+{
+    return std::ranges::find( found, critter ) != found.end();
+}
+
+TEST_CASE( "creature_tracker_finds_monsters_in_radius", "[creature_tracker]" )
+{
+    Creature_tracker tracker;
+    monster *center = add_monster( tracker, "mon_zombie", tripoint( 60, 60, 0 ) );
+    // Right across a bucket border from the center
+    monster *near_x = add_monster( tracker, "mon_zombie", tripoint( 65, 60, 0 ) );
+    monster *near_z = add_monster( tracker, "mon_dog", tripoint( 58, 62, 1 ) );
+    monster *far = add_monster( tracker, "mon_zombie", tripoint( 80, 60, 0 ) );
+    monster *negative = add_monster( tracker, "mon_zombie", tripoint( -3, -3, 0 ) );
+
+    std::vector<monster *> found = tracker.find_in_radius( tripoint( 60, 60, 0 ), 5 );
+    CHECK( found.size() == 3 );
+    CHECK( contains( found, center ) );
+    CHECK( contains( found, near_x ) );
+    CHECK( contains( found, near_z ) );
+
+    CHECK( tracker.find_in_radius( tripoint( 0, 0, 0 ), 3 ) == std::vector<monster *> { negative } );
+    CHECK( tracker.find_in_radius( tripoint( 60, 60, 0 ), 1000 ).size() == 5 );
+    CHECK( tracker.find_in_radius( tripoint( 60, 60, 0 ), -1 ).empty() );
+
+    SECTION( "faction filter" ) {
+        found = tracker.find_in_radius( tripoint( 60, 60, 0 ), 5, near_z->faction );
+        CHECK( found == std::vector<monster *> { near_z } );
+    }
+
+    SECTION( "moved monsters are found at their new position" ) {
+        REQUIRE( tracker.update_pos( *far, tripoint( 61, 61, 0 ) ) );
+        far->spawn( tripoint( 61, 61, 0 ) );
+        CHECK( contains( tracker.find_in_radius( tripoint( 60, 60, 0 ), 5 ), far ) );
+        CHECK( tracker.find_in_radius( tripoint( 80, 60, 0 ), 5 ).empty() );
+    }
+
+    SECTION( "removed and dead monsters are not found" ) {
+        tracker.remove( *near_x );
+        near_z->set_hp( 0 );
+        CHECK( tracker.find_in_radius( tripoint( 60, 60, 0 ), 5 ) == std::vector<monster *> { center } );
+    }
+
+    SECTION( "nearest monsters come first" ) {
+        CHECK( tracker.find_nearest( tripoint( 79, 60, 0 ), 2, 100 ) ==
+               std::vector<monster *> { far, near_x } );
+        CHECK( tracker.find_nearest( tripoint( 79, 60, 0 ), 2, 10 ) == std::vector<monster *> { far } );
+        CHECK( tracker.find_nearest( tripoint( 79, 60, 0 ), 10, 1000 ).size() == 5 );
+    }
+}
@@ -0,0 +1,125 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "calendar.h"
+#include "field.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "map.h"
+#include "mapdata.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static std::vector<field_type_id> types_in( const field &fld )
+{
+    std::vector<field_type_id> types;
+    for( const auto &entry : fld ) {
+        types.push_back( entry.first );
+    }
+    return types;
+}
+
+TEST_CASE( "field_entries_are_ordered_and_stable", "[field]" )
+{
+    const std::vector<field_type_id> added = {
+        field_type_id( "fd_smoke" ), field_type_id( "fd_blood" ), field_type_id( "fd_fire" ),
+        field_type_id( "fd_acid" ), field_type_id( "fd_web" )
+    };
+    std::vector<field_type_id> sorted = added;
+    std::sort( sorted.begin(), sorted.end() );
+
+    field fld;
+    CHECK( fld.begin() == fld.end() );
+    REQUIRE( fld.add_field( added[0] ) );
+    field_entry *const first = fld.find_field( added[0] );
+    REQUIRE( first != nullptr );
+
+    // More entries than fit inline
+    for( size_t i = 1; i < added.size(); i++ ) {
+        REQUIRE( fld.add_field( added[i] ) );
+    }
+    CHECK_FALSE( fld.add_field( added[0] ) );
+    CHECK( fld.field_count() == added.size() );
+    CHECK( fld.find_field( added[0] ) == first );
+    CHECK( types_in( fld ) == sorted );
+
+    SECTION( "copies hold the same entries" ) {
+        const field copy = fld;
+        CHECK( types_in( copy ) == sorted );
+        CHECK( copy.find_field( added[0] ) != first );
+    }
+
+    SECTION( "entries can be removed while iterating" ) {
+        for( auto it = fld.begin(); it != fld.end(); ) {
+            if( it->first == added[1] || it->first == added[3] ) {
+                fld.remove_field( it++ );
+            } else {
+                ++it;
+            }
+        }
+        CHECK( fld.field_count() == added.size() - 2 );
+        CHECK( fld.find_field( added[1] ) == nullptr );
+        CHECK( fld.find_field( added[0] ) == first );
+        CHECK( fld.find_field( added[4] ) != nullptr );
+    }
+
+    SECTION( "removing every entry leaves an empty field" ) {
+        for( const field_type_id &type : added ) {
+            CHECK( fld.remove_field( type ) );
+        }
+        CHECK_FALSE( fld.displayed_field_type() );
+        CHECK( fld.field_count() == 0 );
+        CHECK( fld.begin() == fld.end() );
+    }
+}
+
+// Blocks of wooden houses with tables, a quarter of them on fire, and blood in the streets
+static void build_burning_city()
+{
+    clear_all_state();
+    map &here = get_map();
+    const field_type_id fd_fire( "fd_fire" );
+    const field_type_id fd_smoke( "fd_smoke" );
+    const field_type_id fd_blood( "fd_blood" );
+
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const tripoint p( x, y, 0 );
+            const point in_block( x % 12, y % 12 );
+            const bool burning = ( x / 12 + y / 12 ) % 4 == 0;
+            if( in_block.x < 2 || in_block.y < 2 ) {
+                here.ter_set( p, t_dirt );
+                if( one_in( 8 ) ) {
+                    here.add_field( p, fd_blood, rng( 1, 3 ) );
+                }
+            } else if( in_block.x == 2 || in_block.y == 2 || in_block.x == 11 || in_block.y == 11 ) {
+                here.ter_set( p, t_wall_wood );
+            } else {
+                here.ter_set( p, t_floor );
+                if( one_in( 4 ) ) {
+                    here.furn_set( p, f_table );
+                }
+                if( burning && one_in( 3 ) ) {
+                    here.add_field( p, fd_fire, rng( 1, 3 ) );
+                    here.add_field( p, fd_smoke, rng( 1, 3 ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "field_processing_benchmark", "[field][benchmark][.]" )
+{
+    map &here = get_map();
+    BENCHMARK_ADVANCED( "burning city" )( Catch::Benchmark::Chronometer meter ) {
+        build_burning_city();
+        meter.measure( [&here] {
+            calendar::turn += 1_turns;
+            here.process_fields();
+        } );
+    };
+}
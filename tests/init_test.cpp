@@ -0,0 +1,70 @@
+#include "catch/catch.hpp"
+
+#include <map>
+#include <string>
+
+#include "game.h"
+#include "init.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "loading_ui.h"
+#include "monstergenerator.h"
+#include "mtype.h"
+#include "options_helpers.h"
+#include "state_helpers.h"
+
+// Loaded item and monster types, with a few of their values
+static std::map<std::string, std::string> summarize_loaded_data()
+{
+    std::map<std::string, std::string> summary;
+    for( const itype *type : item_controller->all() ) {
+        summary["item " + type->get_id().str()] = type->nname( 1 ) + " " +
+                std::to_string( type->volume.value() ) + " " + std::to_string( type->weight.value() );
+    }
+    for( const mtype &type : MonsterGenerator::generator().get_all_mtypes() ) {
+        summary["monster " + type.id.str()] = type.nname() + " " + std::to_string( type.hp ) + " " +
+                                              std::to_string( type.speed );
+    }
+    return summary;
+}
+
+TEST_CASE( "data_loads_the_same_with_and_without_reading_ahead", "[init]" )
+{
+    clear_all_state();
+    loading_ui ui( false );
+
+    std::map<std::string, std::string> read_ahead;
+    {
+        override_option prefetch( "PREFETCH_DATA_FILES", "true" );
+        init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
+        read_ahead = summarize_loaded_data();
+    }
+    std::map<std::string, std::string> read_in_turn;
+    {
+        override_option prefetch( "PREFETCH_DATA_FILES", "false" );
+        init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
+        read_in_turn = summarize_loaded_data();
+    }
+    CHECK( init::is_data_loaded() );
+    CHECK_FALSE( read_ahead.empty() );
+    CHECK( read_ahead == read_in_turn );
+    clear_all_state();
+}
+
+TEST_CASE( "data_is_loaded_after_skipping_verified_checks", "[init]" )
+{
+    override_option verified_cache( "VERIFIED_DATA_CACHE", "true" );
+    clear_all_state();
+    loading_ui ui( false );
+    DynamicDataLoader &loader = DynamicDataLoader::get_instance();
+
+    init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
+    REQUIRE( init::is_data_loaded() );
+    // Errors reported by earlier tests keep the load from remembering it passed
+    loader.remember_data_verified();
+
+    init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
+    CHECK( loader.is_data_verified() );
+    CHECK( init::is_data_loaded() );
+    clear_all_state();
+}
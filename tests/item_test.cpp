@@ -3,8 +3,10 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "calendar.h"
+#include "cata_arena.h"
 #include "enums.h"
 #include "item.h"
 #include "itype.h"
@@ -297,3 +299,46 @@ TEST_CASE( "items_have_default_attack_statblocks", "[item]" )
         CHECK( du.res_pen == 0.0f );
     }
 }
+
+TEST_CASE( "item_arena_reuses_released_slots", "[item]" )
+{
+    cleanup_arenas();
+    const cata_arena_stats before = cata_arena<item>::get_stats();
+    REQUIRE( before.pending == 0 );
+
+    const item *first_address = nullptr;
+    {
+        detached_ptr<item> first = item::spawn( "rock" );
+        first_address = &*first;
+        CHECK( cata_arena<item>::get_stats().live == before.live + 1 );
+    }
+    // Dropped items are only deleted at the end of the turn
+    CHECK( cata_arena<item>::get_stats().pending == 1 );
+    CHECK( cata_arena<item>::get_stats().live == before.live + 1 );
+
+    cleanup_arenas();
+    const cata_arena_stats after = cata_arena<item>::get_stats();
+    CHECK( after.pending == 0 );
+    CHECK( after.live == before.live );
+    CHECK( after.releases == before.releases + 1 );
+
+    // The slot of the deleted item is the first one handed out again
+    detached_ptr<item> second = item::spawn( "rock" );
+    CHECK( &*second == first_address );
+    CHECK( cata_arena<item>::get_stats().heap_fallbacks == before.heap_fallbacks );
+}
+
+TEST_CASE( "item_churn_benchmark", "[item][benchmark][.]" )
+{
+    cleanup_arenas();
+    BENCHMARK( "spawn and delete 1000 items" ) {
+        std::vector<detached_ptr<item>> items;
+        items.reserve( 1000 );
+        for( int i = 0; i < 1000; i++ ) {
+            items.push_back( item::spawn( "rock" ) );
+        }
+        items.clear();
+        cleanup_arenas();
+        return cata_arena<item>::get_stats().live;
+    };
+}
@@ -1,12 +1,17 @@
 #include "catch/catch.hpp"
 
+#include <chrono>
+#include <functional>
 #include <list>
 #include <sstream>
+#include <string_view>
 
 #include "bodypart.h"
 #include "json.h"
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "filesystem.h"
+#include "path_info.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
@@ -21,6 +26,13 @@ void test_serialization( const T &val, const std::string &s )
         jsout.write( val );
         CHECK( os.str() == s );
     }
+    {
+        INFO( "test_serialization_to_buffer" );
+        std::string buffer;
+        JsonOut jsout( buffer );
+        jsout.write( val );
+        CHECK( buffer == s );
+    }
     {
         INFO( "test_deserialization" );
         std::istringstream is( s );
@@ -246,12 +258,15 @@ TEST_CASE( "translation_text_style_check_error_recovery", "[json][translation]"
     }
 }
 
+// Reading from a stream and from a buffer should give the same results and errors
 static void test_get_string( const std::string &str, const std::string &json )
 {
     CAPTURE( json );
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK( jsin.get_string() == str );
+    JsonIn jsin_buffer{ std::string_view( json ) };
+    CHECK( jsin_buffer.get_string() == str );
 }
 
 template<typename Matcher>
@@ -261,6 +276,8 @@ static void test_get_string_throws_matches( Matcher &&matcher, const std::string
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    JsonIn jsin_buffer{ std::string_view( json ) };
+    CHECK_THROWS_MATCHES( jsin_buffer.get_string(), JsonError, matcher );
 }
 
 template<typename Matcher>
@@ -272,6 +289,8 @@ static void test_string_error_throws_matches( Matcher &&matcher, const std::stri
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    JsonIn jsin_buffer{ std::string_view( json ) };
+    CHECK_THROWS_MATCHES( jsin_buffer.string_error( "<message>", offset ), JsonError, matcher );
 }
 
 TEST_CASE( "jsonin_get_string", "[json]" )
@@ -481,3 +500,226 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+// Walks the whole document, reading every value, and returns it written out again
+static std::string reread_json( JsonIn &jsin )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    std::function<void()> copy_value = [&]() {
+        if( jsin.test_object() ) {
+            jsout.start_object();
+            jsin.start_object();
+            while( !jsin.end_object() ) {
+                jsout.member( jsin.get_member_name() );
+                copy_value();
+            }
+            jsout.end_object();
+        } else if( jsin.test_array() ) {
+            jsout.start_array();
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                copy_value();
+            }
+            jsout.end_array();
+        } else if( jsin.test_string() ) {
+            jsout.write( jsin.get_string() );
+        } else if( jsin.test_bool() ) {
+            jsout.write( jsin.get_bool() );
+        } else if( jsin.test_null() ) {
+            jsin.skip_null();
+            jsout.write_null();
+        } else {
+            jsout.write( jsin.get_float() );
+        }
+    };
+    copy_value();
+    return os.str();
+}
+
+TEST_CASE( "jsonin_buffer_matches_stream", "[json]" )
+{
+    restore_on_out_of_scope<error_log_format_t> restore_error_log_format( error_log_format );
+    error_log_format = error_log_format_t::human_readable;
+
+    const std::string json =
+        "{\n  \"id\": \"test\",\t\"list\": [ 1, -2.5, 3e2, true, false, null ],\r\n"
+        "  \"nested\": { \"text\": \"a longer string with \\\"escapes\\\" and \\u2026 and \xe2\x80\xa6 in it\" },\n"
+        "  \"empty\": [ ], \"obj\": { }\n}\n";
+    std::istringstream iss( json );
+    JsonIn jsin( iss );
+    const std::string from_stream = reread_json( jsin );
+    JsonIn jsin_buffer{ std::string_view( json ) };
+    CHECK( reread_json( jsin_buffer ) == from_stream );
+
+    // Errors point to the same place
+    const std::string broken = "{\n  \"a\": [ 1, 2 ],\n  \"b\": [ 1 2 ]\n}";
+    std::string stream_error;
+    std::string buffer_error;
+    try {
+        std::istringstream broken_iss( broken );
+        JsonIn broken_jsin( broken_iss );
+        reread_json( broken_jsin );
+    } catch( const JsonError &err ) {
+        stream_error = err.what();
+    }
+    try {
+        JsonIn broken_jsin{ std::string_view( broken ) };
+        reread_json( broken_jsin );
+    } catch( const JsonError &err ) {
+        buffer_error = err.what();
+    }
+    CHECK_FALSE( stream_error.empty() );
+    CHECK( buffer_error == stream_error );
+}
+
+static void write_save_like_json( JsonOut &jsout, int count )
+{
+    jsout.start_array();
+    for( int i = 0; i < count; i++ ) {
+        jsout.start_object();
+        jsout.member( "typeid", "rock" );
+        jsout.member( "charges", i % 50 );
+        jsout.member( "bday", i * 7 );
+        jsout.member( "damage", i * 0.25 );
+        jsout.member( "active", i % 3 == 0 );
+        jsout.member( "item_vars" );
+        jsout.start_object();
+        jsout.member( "name", "a \"named\" thing\n" );
+        jsout.end_object();
+        jsout.member( "pos", std::vector<int> { i % 12, i / 12 % 12, 0 } );
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+TEST_CASE( "jsonout_buffer_matches_stream", "[json]" )
+{
+    const auto write_values = []( JsonOut & jsout ) {
+        jsout.start_object();
+        jsout.member( "ints", std::vector<int64_t> { 0, -1, 42, std::numeric_limits<int64_t>::min(),
+                      std::numeric_limits<int64_t>::max()
+                                                   } );
+        jsout.member( "unsigned", std::numeric_limits<uint64_t>::max() );
+        jsout.member( "floats", std::vector<double> { 0.0, -0.0, 1.5, -2.25, 1e-9, 123456789.123456789,
+                      1e300
+                                                     } );
+        jsout.member( "float", 0.1f );
+        jsout.member( "bools", std::vector<bool> { true, false } );
+        jsout.member( "char", 'x' );
+        jsout.member( "text", std::string( "tab\tquote\"slash/\\bell\x07\x1f end \xe2\x80\xa6" ) );
+        jsout.end_object();
+        write_save_like_json( jsout, 30 );
+    };
+    for( const bool pretty : { false, true } ) {
+        CAPTURE( pretty );
+        std::ostringstream os;
+        JsonOut jsout_stream( os, pretty );
+        write_values( jsout_stream );
+        std::string buffer = "prefix ";
+        JsonOut jsout_buffer( buffer, pretty );
+        write_values( jsout_buffer );
+        CHECK( buffer == "prefix " + os.str() );
+    }
+
+    // Seeking back overwrites like it does on a stream
+    std::ostringstream os;
+    JsonOut jsout_stream( os );
+    std::string buffer;
+    JsonOut jsout_buffer( buffer );
+    for( JsonOut *jsout : { &jsout_stream, &jsout_buffer } ) {
+        jsout->start_array();
+        const int pos = jsout->tell();
+        jsout->write( 123456 );
+        jsout->seek( pos );
+        jsout->write( 7 );
+        jsout->end_array();
+    }
+    CHECK( os.str() == "[7]3456" );
+    CHECK( buffer == os.str() );
+}
+
+TEST_CASE( "json_write_throughput", "[.][benchmark][json]" )
+{
+    constexpr int count = 200000;
+    constexpr int repeats = 5;
+    const auto start_stream = std::chrono::steady_clock::now();
+    size_t total_bytes = 0;
+    for( int i = 0; i < repeats; i++ ) {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        write_save_like_json( jsout, count );
+        total_bytes += os.str().size();
+    }
+    const double stream_time = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                               start_stream ).count();
+
+    const auto start_buffer = std::chrono::steady_clock::now();
+    std::string buffer;
+    for( int i = 0; i < repeats; i++ ) {
+        buffer.clear();
+        JsonOut jsout( buffer );
+        write_save_like_json( jsout, count );
+    }
+    const double buffer_time = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                               start_buffer ).count();
+
+    const double megabytes = total_bytes / ( 1024.0 * 1024.0 );
+    cata_printf( "Wrote %.1f MiB\n", megabytes );
+    cata_printf( "std::ostream: %.3f s, %.1f MiB/s\n", stream_time, megabytes / stream_time );
+    cata_printf( "buffer:       %.3f s, %.1f MiB/s\n", buffer_time, megabytes / buffer_time );
+}
+
+TEST_CASE( "json_parse_throughput", "[.][benchmark][json]" )
+{
+    std::vector<std::string> documents;
+    for( const std::string &path : get_files_from_path( ".json", PATH_INFO::datadir() + "json", true,
+            true ) ) {
+        documents.push_back( read_entire_file( path ) );
+    }
+    // Something shaped like a large save: many nested objects with short strings and numbers
+    {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.start_array();
+        for( int i = 0; i < 200000; i++ ) {
+            jsout.start_object();
+            jsout.member( "typeid", "rock" );
+            jsout.member( "charges", i % 50 );
+            jsout.member( "bday", i * 7 );
+            jsout.member( "item_vars" );
+            jsout.start_object();
+            jsout.member( "name", "a \"named\" thing" );
+            jsout.end_object();
+            jsout.member( "pos", std::vector<int> { i % 12, i / 12 % 12, 0 } );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        documents.push_back( os.str() );
+    }
+
+    size_t total_bytes = 0;
+    for( const std::string &doc : documents ) {
+        total_bytes += doc.size();
+    }
+    const auto time_parse = [&]( bool buffer ) {
+        const auto start = std::chrono::steady_clock::now();
+        for( const std::string &doc : documents ) {
+            if( buffer ) {
+                JsonIn jsin{ std::string_view( doc ) };
+                reread_json( jsin );
+            } else {
+                std::istringstream iss( doc );
+                JsonIn jsin( iss );
+                reread_json( jsin );
+            }
+        }
+        return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    };
+    const double stream_time = time_parse( false );
+    const double buffer_time = time_parse( true );
+    const double megabytes = total_bytes / ( 1024.0 * 1024.0 );
+    cata_printf( "Parsed %.1f MiB in %d documents\n", megabytes, static_cast<int>( documents.size() ) );
+    cata_printf( "std::istream: %.3f s, %.1f MiB/s\n", stream_time, megabytes / stream_time );
+    cata_printf( "buffer:       %.3f s, %.1f MiB/s\n", buffer_time, megabytes / buffer_time );
+}
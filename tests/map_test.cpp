@@ -1,18 +1,61 @@
 #include "catch/catch.hpp"
 
+#include <iterator>
 #include <memory>
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
 #include "point.h"
 #include "state_helpers.h"
 #include "type_id.h"
 
+namespace
+{
+
+struct level_cache_copy {
+    std::vector<float> transparency;
+    std::vector<bool> floor;
+    std::vector<bool> outside;
+};
+
+// Marks every level dirty and rebuilds the caches, then copies out what was built
+std::vector<level_cache_copy> rebuild_level_caches( map &here )
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        here.set_transparency_cache_dirty( z );
+        here.set_floor_cache_dirty( z );
+        here.set_outside_cache_dirty( z );
+    }
+    here.build_map_cache( 0 );
+    std::vector<level_cache_copy> copies;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const level_cache &cache = here.get_cache_ref( z );
+        level_cache_copy copy;
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            copy.transparency.insert( copy.transparency.end(), std::begin( cache.transparency_cache[x] ),
+                                      std::end( cache.transparency_cache[x] ) );
+            copy.floor.insert( copy.floor.end(), std::begin( cache.floor_cache[x] ),
+                               std::end( cache.floor_cache[x] ) );
+            copy.outside.insert( copy.outside.end(), std::begin( cache.outside_cache[x] ),
+                                 std::end( cache.outside_cache[x] ) );
+        }
+        copies.push_back( std::move( copy ) );
+    }
+    return copies;
+}
+
+} // namespace
+
 TEST_CASE( "destroy_grabbed_furniture" )
 {
     clear_all_state();
@@ -75,6 +118,25 @@ TEST_CASE( "tinymap_bounds_checking" )
     }
 }
 
+TEST_CASE( "generate_missing_omt_fills_whole_quad_once" )
+{
+    clear_all_state();
+    // Far outside the reality bubble, so nothing has been generated there yet
+    const tripoint om_addr( 40, 40, 0 );
+    const tripoint abs_sub = omt_to_sm_copy( om_addr );
+    REQUIRE_FALSE( MAPBUFFER.is_submap_loaded( abs_sub ) );
+
+    map::generate_missing_omt( abs_sub + point_south_east );
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        CHECK( MAPBUFFER.is_submap_loaded( abs_sub + offset ) );
+    }
+    const submap *generated = MAPBUFFER.lookup_submap( abs_sub );
+    CHECK_FALSE( map::generate_missing_omt( abs_sub ) );
+    CHECK( MAPBUFFER.lookup_submap( abs_sub ) == generated );
+}
+
 TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
 {
     clear_all_state();
@@ -144,3 +206,41 @@ TEST_CASE( "bash_through_roof_can_destroy_multiple_times" )
         }
     }
 }
+
+TEST_CASE( "map_caches_built_in_parallel_match_serial_build", "[map]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+
+    static const ter_str_id t_flat_roof( "t_flat_roof" );
+    // A basement, a house with a window and a smoky room, a roof and open air above
+    for( int x = 50; x < 80; x++ ) {
+        for( int y = 50; y < 80; y++ ) {
+            const bool edge = x == 50 || x == 79 || y == 50 || y == 79;
+            here.ter_set( tripoint( x, y, -1 ), edge ? t_rock : t_floor );
+            here.ter_set( tripoint( x, y, 0 ), edge ? ( y == 60 ? t_window : t_wall ) : t_floor );
+            here.ter_set( tripoint( x, y, 1 ), x < 65 ? t_flat_roof : t_open_air );
+        }
+    }
+    here.ter_set( tripoint( 70, 70, 1 ), t_wall );
+    here.add_field( tripoint( 60, 65, 0 ), field_type_id( "fd_smoke" ), 3 );
+
+    std::vector<level_cache_copy> serial;
+    std::vector<level_cache_copy> parallel;
+    {
+        restore_on_out_of_scope<bool> restore_parallel( parallel_map_cache );
+        parallel_map_cache = false;
+        serial = rebuild_level_caches( here );
+        parallel_map_cache = true;
+        parallel = rebuild_level_caches( here );
+    }
+
+    REQUIRE( serial.size() == parallel.size() );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        CAPTURE( static_cast<int>( i ) - OVERMAP_DEPTH );
+        CHECK( serial[i].transparency == parallel[i].transparency );
+        CHECK( serial[i].floor == parallel[i].floor );
+        CHECK( serial[i].outside == parallel[i].outside );
+    }
+}
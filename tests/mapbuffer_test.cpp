@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "mapbuffer.h"
+#include "submap.h"
+
+static void add_uniform_quad( mapbuffer &buffer, const tripoint &om_addr,
+                              const time_point &last_touched )
+{
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        const tripoint sm_addr = omt_to_sm_copy( om_addr ) + offset;
+        auto sm = std::make_unique<submap>( sm_to_ms_copy( sm_addr ) );
+        // Uniform quads are dropped without being written to the save
+        sm->is_uniform = true;
+        sm->last_touched = last_touched;
+        REQUIRE( buffer.add_submap( sm_addr, sm ) );
+    }
+}
+
+TEST_CASE( "mapbuffer_evicts_least_recently_touched_distant_quads", "[mapbuffer]" )
+{
+    mapbuffer buffer;
+    const tripoint map_origin = tripoint_zero;
+    const tripoint near_quad( 1, 1, 0 );
+    const tripoint oldest_quad( 100, 0, 0 );
+    const tripoint older_quad( -200, 0, 1 );
+    const tripoint newest_quad( 300, 0, 0 );
+
+    // The quad next to the map is the oldest of all, but must be kept anyway
+    add_uniform_quad( buffer, near_quad, calendar::turn_zero );
+    add_uniform_quad( buffer, oldest_quad, calendar::turn_zero + 1_hours );
+    add_uniform_quad( buffer, older_quad, calendar::turn_zero + 2_hours );
+    add_uniform_quad( buffer, newest_quad, calendar::turn_zero + 3_hours );
+    REQUIRE( buffer.size() == 16 );
+
+    SECTION( "no limit keeps everything" ) {
+        CHECK( buffer.evict_cold_submaps( map_origin, 0 ) == 0 );
+        CHECK( buffer.size() == 16 );
+    }
+
+    SECTION( "buffer within limit keeps everything" ) {
+        CHECK( buffer.evict_cold_submaps( map_origin, 16 ) == 0 );
+        CHECK( buffer.size() == 16 );
+    }
+
+    SECTION( "buffer over limit evicts the coldest distant quads" ) {
+        CHECK( buffer.evict_cold_submaps( map_origin, 12 ) == 8 );
+        CHECK( buffer.size() == 8 );
+        CHECK( buffer.get_stats().evictions == 8 );
+        CHECK( buffer.is_submap_loaded( omt_to_sm_copy( near_quad ) ) );
+        CHECK( buffer.is_submap_loaded( omt_to_sm_copy( newest_quad ) ) );
+        CHECK_FALSE( buffer.is_submap_loaded( omt_to_sm_copy( oldest_quad ) ) );
+        CHECK_FALSE( buffer.is_submap_loaded( omt_to_sm_copy( older_quad ) ) );
+    }
+
+    SECTION( "eviction is spread over calls" ) {
+        CHECK( buffer.evict_cold_submaps( map_origin, 4, 1 ) == 4 );
+        CHECK_FALSE( buffer.is_submap_loaded( omt_to_sm_copy( oldest_quad ) ) );
+        CHECK( buffer.is_submap_loaded( omt_to_sm_copy( older_quad ) ) );
+        CHECK( buffer.evict_cold_submaps( map_origin, 4, 1 ) == 4 );
+        CHECK( buffer.evict_cold_submaps( map_origin, 4, 1 ) == 4 );
+        // Only the quad next to the map is left, even though it is over the limit
+        CHECK( buffer.evict_cold_submaps( map_origin, 2, 1 ) == 0 );
+        CHECK( buffer.size() == 4 );
+    }
+
+    SECTION( "lookups of buffered submaps count as hits" ) {
+        CHECK( buffer.lookup_submap( omt_to_sm_copy( near_quad ) ) != nullptr );
+        CHECK( buffer.get_stats().hits == 1 );
+        CHECK( buffer.get_stats().misses == 0 );
+    }
+}
@@ -10,6 +10,7 @@
 #include "monster.h"
 #include "options_helpers.h"
 #include "state_helpers.h"
+#include "type_id.h"
 
 struct tripoint;
 
@@ -79,6 +80,33 @@ TEST_CASE( "monsters shouldn't see through floors", "[vision]" )
     fov_3d = old_fov_3d;
 }
 
+TEST_CASE( "monster_sight_follows_changes_within_a_turn", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    monster &watcher = spawn_and_clear( { 50, 50, 0 }, true );
+    monster &target = spawn_and_clear( { 50, 55, 0 }, true );
+    get_map().build_map_cache( 0 );
+
+    REQUIRE( watcher.sees( target ) );
+    // Asked again, the answer comes from the cache
+    CHECK( watcher.sees( target ) );
+
+    watcher.add_effect( efftype_id( "no_sight" ), 1_hours );
+    CHECK_FALSE( watcher.sees( target ) );
+    watcher.remove_effect( efftype_id( "no_sight" ) );
+    CHECK( watcher.sees( target ) );
+
+    get_map().ter_set( { 50, 53, 0 }, t_wall );
+    get_map().build_map_cache( 0 );
+    CHECK_FALSE( watcher.sees( target ) );
+    CHECK_FALSE( target.sees( watcher ) );
+
+    target.setpos( { 51, 51, 0 } );
+    CHECK( watcher.sees( target ) );
+}
+
 TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
 {
     clear_all_state();
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "calendar.h"
@@ -39,6 +41,60 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "overmap_layers_survive_save_and_load", "[overmap]" )
+{
+    clear_all_state();
+    std::unique_ptr<overmap> saved = std::make_unique<overmap>( point_abs_om() );
+
+    const tripoint_om_omt changed( 17, 123, -3 );
+    const oter_id below = saved->ter( changed );
+    const oter_id above = saved->ter( tripoint_om_omt( 0, 0, 5 ) );
+    REQUIRE( below != above );
+
+    saved->ter_set( changed, above );
+    saved->set_seen( tripoint_om_omt( 0, 0, 0 ), true );
+    saved->set_seen( tripoint_om_omt( OMAPX - 1, OMAPY - 1, 0 ), true );
+    saved->set_explored( changed, true );
+    saved->set_path( tripoint_om_omt( 90, 91, 0 ), true );
+    // Out of bounds writes are ignored.
+    saved->set_seen( tripoint_om_omt( OMAPX, 0, 0 ), true );
+    CHECK_FALSE( saved->seen( tripoint_om_omt( OMAPX, 0, 0 ) ) );
+
+    CHECK( saved->ter( changed ) == above );
+    CHECK( saved->ter( changed + point_east ) == below );
+    CHECK( saved->ter( changed + tripoint_above ) == below );
+
+    std::ostringstream terrain;
+    std::ostringstream view;
+    saved->serialize( terrain );
+    saved->serialize_view( view );
+
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( point_abs_om() );
+    std::istringstream terrain_in( terrain.str() );
+    std::istringstream view_in( view.str() );
+    loaded->unserialize( terrain_in, "overmap terrain" );
+    loaded->unserialize_view( view_in, "overmap view" );
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                const tripoint_om_omt p( x, y, z );
+                REQUIRE( loaded->ter( p ) == saved->ter( p ) );
+                REQUIRE( loaded->seen( p ) == saved->seen( p ) );
+                REQUIRE( loaded->is_explored( p ) == saved->is_explored( p ) );
+                REQUIRE( loaded->is_path( p ) == saved->is_path( p ) );
+            }
+        }
+    }
+
+    std::ostringstream terrain_again;
+    std::ostringstream view_again;
+    loaded->serialize( terrain_again );
+    loaded->serialize_view( view_again );
+    CHECK( terrain_again.str() == terrain.str() );
+    CHECK( view_again.str() == view.str() );
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     clear_all_state();
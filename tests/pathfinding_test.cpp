@@ -0,0 +1,261 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "mtype.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+
+enum class path_fixture {
+    open_field,
+    rooms,
+    maze,
+};
+
+static const char *path_fixture_name( path_fixture fixture )
+{
+    switch( fixture ) {
+        case path_fixture::open_field:
+            return "open field";
+        case path_fixture::rooms:
+            return "rooms";
+        case path_fixture::maze:
+            return "maze";
+    }
+    return "";
+}
+
+// Builds the fixture on z-level 0 of a freshly cleared map
+static void build_path_fixture( path_fixture fixture )
+{
+    clear_all_state();
+    map &here = get_map();
+
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const tripoint p( x, y, 0 );
+            switch( fixture ) {
+                case path_fixture::open_field:
+                    break;
+                case path_fixture::rooms:
+                    // 12x12 rooms with a closed door in the middle of every wall
+                    if( x % 12 == 0 || y % 12 == 0 ) {
+                        const bool doorway = x % 12 == 6 || y % 12 == 6;
+                        here.ter_set( p, doorway ? t_door_c : t_wall );
+                    }
+                    break;
+                case path_fixture::maze:
+                    // Walls every 6 columns, open alternately at the top and the bottom
+                    if( x % 6 == 0 ) {
+                        const bool open_at_top = x % 12 == 0;
+                        if( open_at_top ? y > 2 : y < MAPSIZE_Y - 3 ) {
+                            here.ter_set( p, t_wall );
+                        }
+                    }
+                    break;
+            }
+        }
+    }
+    Pathfinding::clear_d_maps();
+    Pathfinding::reset_stats();
+}
+
+struct horde_member {
+    tripoint pos;
+    tripoint goal;
+    PathfindingSettings path_settings;
+    RouteSettings route_settings;
+};
+
+// Monsters of varied types, scattered over the map and hunting one of a few targets
+static std::vector<horde_member> make_horde( int size )
+{
+    static const std::vector<std::string> types = {
+        "mon_zombie", "mon_zombie_brute", "mon_zombie_hulk", "mon_dog", "mon_bee"
+    };
+    const std::vector<tripoint> goals = {
+        tripoint( MAPSIZE_X / 2 + 3, MAPSIZE_Y / 2 + 3, 0 ),
+        tripoint( 15, 15, 0 ),
+        tripoint( MAPSIZE_X - 15, 27, 0 ),
+    };
+    const map &here = get_map();
+
+    std::vector<horde_member> horde;
+    while( static_cast<int>( horde.size() ) < size ) {
+        const tripoint pos( rng( 1, MAPSIZE_X - 2 ), rng( 1, MAPSIZE_Y - 2 ), 0 );
+        if( here.impassable( pos ) ) {
+            continue;
+        }
+        const mtype &type = mtype_id( random_entry( types ) ).obj();
+        horde.push_back( horde_member{ pos, random_entry( goals ), type.path_settings, type.route_settings } );
+    }
+    return horde;
+}
+
+// Paths the whole horde once, as happens over the course of one turn
+static int route_horde( const std::vector<horde_member> &horde )
+{
+    int found = 0;
+    for( const horde_member &member : horde ) {
+        if( !Pathfinding::route( member.pos, member.goal, member.path_settings,
+                                 member.route_settings ).empty() ) {
+            found++;
+        }
+    }
+    Pathfinding::clear_d_maps();
+    return found;
+}
+
+TEST_CASE( "pathfinding_counts_d_map_reuse", "[pathfinding]" )
+{
+    build_path_fixture( path_fixture::open_field );
+    const tripoint goal( 60, 60, 0 );
+
+    CHECK_FALSE( Pathfinding::route( tripoint( 50, 60, 0 ), goal ).empty() );
+    CHECK( Pathfinding::get_stats().routes == 1 );
+    CHECK( Pathfinding::get_stats().d_maps_built == 1 );
+    CHECK( Pathfinding::get_stats().d_maps_reused == 0 );
+    CHECK( Pathfinding::get_stats().tiles_expanded > 0 );
+
+    // Same destination and settings share the d_map
+    CHECK_FALSE( Pathfinding::route( tripoint( 70, 60, 0 ), goal ).empty() );
+    CHECK( Pathfinding::get_stats().d_maps_built == 1 );
+    CHECK( Pathfinding::get_stats().d_maps_reused == 1 );
+
+    PathfindingSettings basher;
+    basher.bash_strength_val = 3;
+    CHECK_FALSE( Pathfinding::route( tripoint( 70, 60, 0 ), goal, basher ).empty() );
+    CHECK( Pathfinding::get_stats().d_maps_built == 2 );
+
+    Pathfinding::clear_d_maps();
+    CHECK( Pathfinding::get_stats().d_maps_invalidated == 2 );
+    CHECK( Pathfinding::get_last_turn_stats().routes == 3 );
+    CHECK( Pathfinding::get_last_turn_stats().d_maps_built == 2 );
+
+    // The next turn starts counting from zero
+    Pathfinding::clear_d_maps();
+    CHECK( Pathfinding::get_last_turn_stats().routes == 0 );
+    CHECK( Pathfinding::get_stats().routes == 3 );
+}
+
+static void check_route( const std::vector<tripoint> &route, const tripoint &from,
+                         const tripoint &to )
+{
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.front() == from );
+    CHECK( route.back() == to );
+    const map &here = get_map();
+    for( size_t i = 1; i < route.size(); i++ ) {
+        CAPTURE( route[i] );
+        CHECK( square_dist( route[i - 1], route[i] ) <= 1 );
+        CHECK( here.passable( route[i] ) );
+    }
+}
+
+TEST_CASE( "pathfinding_plans_long_routes_over_submaps", "[pathfinding]" )
+{
+    build_path_fixture( path_fixture::maze );
+    const tripoint from( 3, 3, 0 );
+    const tripoint to( MAPSIZE_X - 4, MAPSIZE_Y - 4, 0 );
+
+    RouteSettings flat;
+    flat.max_f_coeff = INFINITY;
+    RouteSettings hierarchical = flat;
+    hierarchical.hierarchical_min_dist = 0;
+
+    const std::vector<tripoint> flat_route = Pathfinding::route( from, to, std::nullopt, flat );
+    check_route( flat_route, from, to );
+    CHECK( Pathfinding::get_stats().abstract_routes == 0 );
+
+    const std::vector<tripoint> route = Pathfinding::route( from, to, std::nullopt, hierarchical );
+    check_route( route, from, to );
+    CHECK( Pathfinding::get_stats().abstract_routes == 1 );
+    const uint64_t clusters_built = Pathfinding::get_stats().clusters_built;
+    CHECK( clusters_built > 0 );
+    // Planning over submaps gives up some precision, but not a lot
+    CHECK( route.size() <= flat_route.size() * 1.2 );
+
+    SECTION( "clusters are reused" ) {
+        Pathfinding::clear_d_maps();
+        check_route( Pathfinding::route( from, to, std::nullopt, hierarchical ), from, to );
+        CHECK( Pathfinding::get_stats().clusters_built == clusters_built );
+    }
+
+    SECTION( "clusters are rebuilt after terrain changes" ) {
+        // Close the first gap of the maze, which is at the bottom
+        for( int y = MAPSIZE_Y - 3; y < MAPSIZE_Y; y++ ) {
+            get_map().ter_set( tripoint( 6, y, 0 ), t_wall );
+        }
+        Pathfinding::clear_d_maps();
+        CHECK( Pathfinding::route( from, to, std::nullopt, hierarchical ).empty() );
+        CHECK( Pathfinding::get_stats().clusters_built > clusters_built );
+    }
+}
+
+TEST_CASE( "pathfinding_submap_plans_cross_doors_only_if_they_can_be_opened", "[pathfinding]" )
+{
+    build_path_fixture( path_fixture::rooms );
+    const tripoint from( 3, 3, 0 );
+    const tripoint to( MAPSIZE_X - 4, MAPSIZE_Y - 4, 0 );
+
+    RouteSettings hierarchical;
+    hierarchical.max_f_coeff = INFINITY;
+    hierarchical.hierarchical_min_dist = 0;
+    PathfindingSettings opens_doors;
+    opens_doors.door_open_cost = 2.0;
+
+    CHECK_FALSE( Pathfinding::route( from, to, opens_doors, hierarchical ).empty() );
+    CHECK( Pathfinding::get_stats().abstract_routes == 1 );
+
+    // No coarse plan through the doors, so nothing gets refined before the full search gives up
+    Pathfinding::clear_d_maps();
+    Pathfinding::reset_stats();
+    CHECK( Pathfinding::route( from, to, PathfindingSettings(), hierarchical ).empty() );
+    CHECK( Pathfinding::get_stats().d_maps_built == 1 );
+}
+
+TEST_CASE( "pathfinding_horde_benchmark", "[pathfinding][benchmark][.]" )
+{
+    for( const path_fixture fixture : {
+             path_fixture::open_field, path_fixture::rooms, path_fixture::maze
+         } ) {
+        for( const int horde_size : {
+                 10, 100
+             } ) {
+            for( const bool hierarchical : {
+                     false, true
+                 } ) {
+                build_path_fixture( fixture );
+                std::vector<horde_member> horde = make_horde( horde_size );
+                for( horde_member &member : horde ) {
+                    member.route_settings.hierarchical_min_dist = hierarchical ? 36 : INFINITY;
+                }
+                const std::string name = string_format( "%s, %d monsters%s", path_fixture_name( fixture ),
+                                                        horde_size, hierarchical ? ", hierarchical" : "" );
+
+                BENCHMARK( std::string( name ) ) {
+                    return route_horde( horde );
+                };
+
+                const pathfinding_stats &stats = Pathfinding::get_last_turn_stats();
+                WARN( string_format( "%s: %d d_maps built, %d reused, %d rebuilt, "
+                                     "%d tiles expanded, %.1f us per route",
+                                     name, stats.d_maps_built, stats.d_maps_reused, stats.d_maps_rebuilt,
+                                     stats.tiles_expanded,
+                                     std::chrono::duration<double, std::micro>( stats.route_time ).count() /
+                                     std::max<uint64_t>( stats.routes, 1 ) ) );
+            }
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include "catch/catch.hpp"
 
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #include "calendar.h"
 #include "enums.h"
@@ -9,6 +11,7 @@
 #include "map_helpers.h"
 #include "game.h" // Just for get_convection_temperature(), TODO: Remove
 #include "point.h"
+#include "string_formatter.h"
 #include "units_temperature.h"
 #include "weather.h"
 
@@ -204,3 +207,77 @@ TEST_CASE( "Items don't rot away on map load if in a freezer" )
     auto normal_stack_after = m.i_at( normal_pnt );
     REQUIRE( normal_stack_after.empty() );
 }
+
+// Items that were out of the reality bubble since the same turn
+static std::vector<detached_ptr<item>> spawn_aged_items( const std::string &id, int count,
+                                    weather_manager &weather )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    std::vector<detached_ptr<item>> items;
+    for( int i = 0; i < count; i++ ) {
+        items.push_back( item::process_rot( item::spawn( id ), false, tripoint_zero, nullptr,
+                                            temperature_flag::TEMP_FRIDGE, weather ) );
+    }
+    return items;
+}
+
+TEST_CASE( "Rot catch-up shares weather history without changing it" )
+{
+    weather_manager weather;
+    const time_point start = calendar::turn;
+    std::vector<detached_ptr<item>> items = spawn_aged_items( "apple", 4, weather );
+    calendar::turn += 5_days;
+
+    const tripoint shelf( 10, 10, 0 );
+    const tripoint other_shelf( 30, 40, 0 );
+    // The first two share the same place, the other two are caught up without any history
+    items[0] = item::process_rot( std::move( items[0] ), false, shelf, nullptr,
+                                  temperature_flag::TEMP_FRIDGE, weather );
+    items[1] = item::process_rot( std::move( items[1] ), false, shelf, nullptr,
+                                  temperature_flag::TEMP_FRIDGE, weather );
+    items[2] = item::process_rot( std::move( items[2] ), false, other_shelf, nullptr,
+                                  temperature_flag::TEMP_FRIDGE, weather );
+    weather.clear_temp_cache();
+    items[3] = item::process_rot( std::move( items[3] ), false, other_shelf, nullptr,
+                                  temperature_flag::TEMP_FRIDGE, weather );
+
+    CHECK( items[0]->get_rot() > 0_turns );
+    CHECK( items[1]->get_rot() == items[0]->get_rot() );
+    CHECK( items[3]->get_rot() == items[2]->get_rot() );
+    calendar::turn = start;
+}
+
+TEST_CASE( "rot_catch_up_perf", "[.][benchmark]" )
+{
+    weather_manager weather;
+    const time_point start = calendar::turn;
+    constexpr int shelves = 20;
+    constexpr int items_per_shelf = 50;
+    std::vector<detached_ptr<item>> shared = spawn_aged_items( "apple", shelves * items_per_shelf,
+            weather );
+    std::vector<detached_ptr<item>> alone = spawn_aged_items( "apple", shelves * items_per_shelf,
+                                            weather );
+    calendar::turn += 14_days;
+    weather.clear_temp_cache();
+
+    const auto catch_up = [&]( std::vector<detached_ptr<item>> &items, bool share ) {
+        const auto start_time = std::chrono::steady_clock::now();
+        for( size_t i = 0; i < items.size(); i++ ) {
+            if( !share ) {
+                weather.clear_temp_cache();
+            }
+            const tripoint shelf( 10 + static_cast<int>( i ) / items_per_shelf, 10, 0 );
+            items[i] = item::process_rot( std::move( items[i] ), false, shelf, nullptr,
+                                          temperature_flag::TEMP_FRIDGE, weather );
+        }
+        return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() -
+                start_time ).count();
+    };
+    const double alone_ms = catch_up( alone, false );
+    const double shared_ms = catch_up( shared, true );
+    cata_printf( "%d items on %d shelves, 14 days: %.1f ms alone, %.1f ms shared\n",
+                 shelves * items_per_shelf, shelves, alone_ms, shared_ms );
+    calendar::turn = start;
+}
@@ -123,6 +123,96 @@ void old_scent_map_update( const tripoint &center, map &m,
     }
 }
 
+// scent_map::update without skipping the squares that have no scent around them
+static void full_scent_map_update( const tripoint &center, map &m,
+                                  std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    using scent_array = std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X>;
+    //the block and reduce scent properties are folded into a single scent_transfer value here
+    //block=0 reduce=1 normal=5
+    scent_array scent_transfer;
+
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    // for loop constants
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    // The new scent flag searching function. Should be wayyy faster than the old one.
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        sum_3_scent_y[0][x] = 0;
+        squares_used_y[0][x] = 0;
+        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
+        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    }
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            //handle vehicle holes
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            //Lingering scent
+            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
+                              scent_transfer[abs.x][abs.y] ) ;
+            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
+                           ( 45 - squares_used ) / 5;
+
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
 TEST_CASE( "scent_matches_old", "[.]" )
 {
     clear_all_state();
@@ -170,3 +260,69 @@ TEST_CASE( "scent_matches_old", "[.]" )
     }
 }
 
+static void check_scent_matches( const std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &expected )
+{
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( expected[x][y] != g->scent.get( { x, y, 0 } ) ) {
+                INFO( x );
+                INFO( y );
+                CHECK( expected[x][y] == g->scent.get( { x, y, 0 } ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "scent_update_matches_full_update", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    for( int y = -5; y <= 5; y++ ) {
+        here.ter_set( origin + point( 3, y ), t_brick_wall );
+    }
+    here.ter_set( origin + point( -2, -2 ), t_rock_wall_half );
+    here.build_map_cache( 0 );
+    g->scent.reset();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> expected{};
+    tripoint center = origin;
+    for( int turn = 0; turn < 50; turn++ ) {
+        if( turn % 10 == 0 ) {
+            // Player walking around, leaving scent behind
+            center += point_north_west;
+            g->scent.set( center, 1000, scenttype_id( "sc_human" ) );
+            expected[center.x][center.y] = 1000;
+        }
+        g->scent.update( center, here );
+        full_scent_map_update( center, here, expected );
+    }
+    check_scent_matches( expected );
+}
+
+TEST_CASE( "scent_update_perf", "[.][benchmark][scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    g->scent.reset();
+    g->scent.set( origin, 1000, scenttype_id( "sc_human" ) );
+    BENCHMARK( "fresh scent trail" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+
+    for( int x = -40; x <= 40; x++ ) {
+        for( int y = -40; y <= 40; y++ ) {
+            g->scent.set( origin + point( x, y ), 500 );
+        }
+    }
+    BENCHMARK( "scent everywhere" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+}
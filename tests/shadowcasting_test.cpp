@@ -3,6 +3,7 @@
 #include <array>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <random>
@@ -670,3 +671,104 @@ TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
     clear_all_state();
     shadowcasting_runoff( 1, true );
 }
+
+// Fixed fixtures for comparing shadowcasting kernels.
+// Walls are laid out with a fixed seed so every kernel sees the same map.
+static void fill_kernel_fixture( float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                                 const unsigned int denominator )
+{
+    std::mt19937 engine( 1337 );
+    std::uniform_int_distribution<unsigned int> distribution( 0, denominator );
+    for( auto &inner : transparency_cache ) {
+        for( float &square : inner ) {
+            const unsigned int roll = distribution( engine );
+            if( roll == 0 ) {
+                square = LIGHT_TRANSPARENCY_SOLID;
+            } else if( roll == 1 ) {
+                // Smoke and similar, forces the slow path
+                square = LIGHT_TRANSPARENCY_OPEN_AIR * 4;
+            } else {
+                square = LIGHT_TRANSPARENCY_OPEN_AIR;
+            }
+        }
+    }
+}
+
+static void cast_with_kernel( const shadowcasting_kernel kernel,
+                              float ( &output )[MAPSIZE_X][MAPSIZE_Y],
+                              const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                              const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y],
+                              const point &offset, const int offset_distance )
+{
+    set_shadowcasting_kernel( kernel );
+    std::uninitialized_fill_n( &output[0][0], MAPSIZE_X * MAPSIZE_Y, LIGHT_TRANSPARENCY_SOLID );
+    castLightAllWithLookup<float, float, sight_calc, sight_check, update_light,
+                           accumulate_transparency, sight_from_lookup>(
+                               output, transparency_cache, blocked_cache, offset, offset_distance );
+}
+
+TEST_CASE( "shadowcasting_kernels_match_per_cell", "[shadowcasting]" )
+{
+    clear_all_state();
+    const shadowcasting_kernel initial = get_shadowcasting_kernel();
+
+    static float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+    static float control[MAPSIZE_X][MAPSIZE_Y];
+    static float experiment[MAPSIZE_X][MAPSIZE_Y];
+    static diagonal_blocks blocked_cache[MAPSIZE_X][MAPSIZE_Y];
+    std::uninitialized_fill_n( &blocked_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
+                               diagonal_blocks{ false, false } );
+    blocked_cache[70][70] = { true, true };
+    blocked_cache[60][61] = { true, false };
+
+    const shadowcasting_kernel kernel = GENERATE( shadowcasting_kernel::scalar,
+                                        shadowcasting_kernel::sse2, shadowcasting_kernel::avx2 );
+    const unsigned int denominator = GENERATE( 3u, 10u, 100u );
+    const point offset = GENERATE( point( 65, 65 ), point( 3, 128 ), point( 131, 0 ) );
+    const int offset_distance = GENERATE( 0, 7 );
+    CAPTURE( shadowcasting_kernel_name( kernel ), denominator, offset, offset_distance );
+
+    fill_kernel_fixture( transparency_cache, denominator );
+    cast_with_kernel( shadowcasting_kernel::per_cell, control, transparency_cache, blocked_cache,
+                      offset, offset_distance );
+    cast_with_kernel( kernel, experiment, transparency_cache, blocked_cache, offset,
+                      offset_distance );
+
+    // Batching must not change a single value, not just visibility.
+    CHECK( std::memcmp( control, experiment, sizeof( control ) ) == 0 );
+
+    set_shadowcasting_kernel( initial );
+}
+
+TEST_CASE( "shadowcasting_kernel_benchmark", "[shadowcasting][benchmark][.]" )
+{
+    clear_all_state();
+    const shadowcasting_kernel initial = get_shadowcasting_kernel();
+
+    static float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+    static float output[MAPSIZE_X][MAPSIZE_Y];
+    static diagonal_blocks blocked_cache[MAPSIZE_X][MAPSIZE_Y];
+    std::uninitialized_fill_n( &blocked_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
+                               diagonal_blocks{ false, false } );
+
+    for( const unsigned int denominator : {
+             10u, 100u, 10000u
+         } ) {
+        fill_kernel_fixture( transparency_cache, denominator );
+        for( const shadowcasting_kernel kernel : {
+                 shadowcasting_kernel::per_cell, shadowcasting_kernel::scalar,
+                 shadowcasting_kernel::sse2, shadowcasting_kernel::avx2
+             } ) {
+            if( set_shadowcasting_kernel( kernel ) != kernel ) {
+                continue;
+            }
+            BENCHMARK( string_format( "%s, 1/%u walls", shadowcasting_kernel_name( kernel ),
+                                      denominator ) ) {
+                return cast_with_kernel( kernel, output, transparency_cache, blocked_cache,
+                                         ORIGIN, 0 );
+            };
+        }
+    }
+
+    set_shadowcasting_kernel( initial );
+}
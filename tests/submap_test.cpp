@@ -3,6 +3,8 @@
 #include "submap.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
+#include "map.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -90,3 +92,38 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_allocates_item_lists_on_demand", "[submap][item]" )
+{
+    submap sm( tripoint( 24, 36, 0 ) );
+    const submap &const_sm = sm;
+    const point p( 3, 4 );
+    const size_t empty_bytes = sm.item_storage_bytes();
+    CHECK( empty_bytes < submap::dense_item_storage_bytes() );
+
+    // Reading doesn't allocate
+    CHECK( const_sm.get_items( p ).empty() );
+    CHECK_FALSE( sm.has_items( p ) );
+    CHECK( sm.item_storage_bytes() == empty_bytes );
+
+    sm.get_items( p ).push_back( item::spawn( "rock" ) );
+    CHECK( sm.has_items( p ) );
+    CHECK( sm.item_storage_bytes() > empty_bytes );
+    item &rock = *sm.get_items( p ).front();
+    CHECK( get_map().getabs( rock.position() ) == tripoint( 27, 40, 0 ) );
+
+    SECTION( "rotation moves items to the location of their new square" ) {
+        sm.rotate( 1 );
+        CHECK_FALSE( sm.has_items( p ) );
+        const point rotated( SEEX - 1 - p.y, p.x );
+        REQUIRE( sm.has_items( rotated ) );
+        CHECK( get_map().getabs( rock.position() ) == tripoint( 24, 36, 0 ) + rotated );
+    }
+
+    SECTION( "lists of squares that were emptied are freed" ) {
+        sm.get_items( p ).clear();
+        sm.get_items( point_zero );
+        sm.shrink_items();
+        CHECK( sm.item_storage_bytes() == empty_bytes );
+    }
+}
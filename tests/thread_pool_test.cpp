@@ -0,0 +1,97 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST_CASE( "thread_pool_runs_all_tasks", "[thread_pool]" )
+{
+    cata::thread_pool pool( 3 );
+    std::vector<std::future<int>> results;
+    for( int i = 0; i < 100; ++i ) {
+        results.push_back( pool.submit( [i]() {
+            return i * i;
+        } ) );
+    }
+    int sum = 0;
+    for( std::future<int> &f : results ) {
+        sum += f.get();
+    }
+    CHECK( sum == 328350 );
+}
+
+TEST_CASE( "thread_pool_propagates_exceptions", "[thread_pool]" )
+{
+    cata::thread_pool pool( 1 );
+    std::future<void> f = pool.submit( []() {
+        throw std::runtime_error( "boom" );
+    } );
+    CHECK_THROWS_AS( f.get(), std::runtime_error );
+}
+
+TEST_CASE( "thread_pool_without_workers_runs_on_caller", "[thread_pool]" )
+{
+    cata::thread_pool pool( 0 );
+    std::future<int> high = pool.submit( []() {
+        return 1;
+    }, cata::task_priority::high );
+    std::future<int> low = pool.submit( []() {
+        return 2;
+    }, cata::task_priority::low );
+    CHECK( pool.num_pending() == 2 );
+
+    // Higher priority tasks are picked first.
+    REQUIRE( pool.run_pending_task() );
+    CHECK( high.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready );
+    CHECK( low.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready );
+    REQUIRE( pool.run_pending_task() );
+    CHECK_FALSE( pool.run_pending_task() );
+    CHECK( high.get() + low.get() == 3 );
+}
+
+TEST_CASE( "thread_pool_cancellation", "[thread_pool]" )
+{
+    cata::thread_pool pool( 0 );
+    cata::cancellation_token token;
+    std::atomic<int> ran{ 0 };
+    std::vector<std::future<void>> results;
+    for( int i = 0; i < 10; ++i ) {
+        results.push_back( pool.submit( [&ran]() {
+            ++ran;
+        }, cata::task_priority::normal, "test", token ) );
+    }
+    token.cancel();
+    while( pool.run_pending_task() ) {}
+
+    CHECK( ran == 0 );
+    for( std::future<void> &f : results ) {
+        CHECK_THROWS_AS( f.get(), cata::task_cancelled );
+    }
+}
+
+TEST_CASE( "thread_pool_nested_submission", "[thread_pool]" )
+{
+    cata::thread_pool pool( 2 );
+    std::future<int> outer = pool.submit( [&pool]() {
+        std::vector<std::future<int>> inner;
+        for( int i = 1; i <= 10; ++i ) {
+            inner.push_back( pool.submit( [i]() {
+                return i;
+            } ) );
+        }
+        int sum = 0;
+        for( std::future<int> &f : inner ) {
+            // Help instead of blocking a worker on its own sub-tasks.
+            while( f.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+                pool.run_pending_task();
+            }
+            sum += f.get();
+        }
+        return sum;
+    } );
+    CHECK( outer.get() == 55 );
+}
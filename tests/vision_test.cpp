@@ -717,3 +717,57 @@ TEST_CASE( "vision_see_into_vehicle", "[shadowcasting][vision]" )
 
     t.test();
 }
+
+TEST_CASE( "vision_cached_light_sources_match_full_rebuild", "[shadowcasting][vision]" )
+{
+    clear_all_state();
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_dirt( "t_dirt" );
+
+    map &here = get_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    calendar::turn = midnight;
+    g->reset_light_level();
+
+    // One light far from the changes below and one right next to them
+    const tripoint far_light( 30, 30, 0 );
+    const tripoint near_light( 70, 70, 0 );
+    here.ter_set( far_light, t_utility_light );
+    here.ter_set( near_light, t_utility_light );
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0 );
+
+    const auto lightmap_snapshot = [&here]() {
+        const level_cache &cache = here.access_cache( 0 );
+        return std::vector<four_quadrants>( &cache.lm[0][0], &cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    };
+    const auto check_against_full_rebuild = [&]( const std::vector<four_quadrants> &incremental ) {
+        here.invalidate_map_cache( 0 );
+        here.build_map_cache( 0 );
+        const std::vector<four_quadrants> full = lightmap_snapshot();
+        for( size_t i = 0; i < full.size(); i++ ) {
+            CAPTURE( i );
+            REQUIRE( incremental[i].values == full[i].values );
+        }
+    };
+
+    SECTION( "wall built next to a light" ) {
+        for( int x = 66; x <= 74; x++ ) {
+            here.ter_set( tripoint( x, 72, 0 ), t_brick_wall );
+        }
+        here.build_map_cache( 0 );
+        check_against_full_rebuild( lightmap_snapshot() );
+    }
+
+    SECTION( "light removed" ) {
+        here.ter_set( near_light, t_dirt );
+        here.build_map_cache( 0 );
+        check_against_full_rebuild( lightmap_snapshot() );
+    }
+
+    SECTION( "nothing changed" ) {
+        here.build_map_cache( 0 );
+        check_against_full_rebuild( lightmap_snapshot() );
+    }
+}
@@ -0,0 +1,90 @@
+#include "catch/catch.hpp"
+
+#include <iterator>
+#include <string>
+
+#include "coordinates.h"
+#include "game.h"
+#include "json.h"
+#include "options_helpers.h"
+#include "world.h"
+
+static std::string read_overmap_data( world &w, const point_abs_om &p )
+{
+    std::string data;
+    w.read_overmap( p, [&]( std::istream & fin ) {
+        data.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    } );
+    return data;
+}
+
+TEST_CASE( "world_save_transaction_data_is_readable_after_commit", "[world][save]" )
+{
+    const std::string async = GENERATE( "true", "false" );
+    CAPTURE( async );
+    override_option opt( "ASYNC_SAVE", async );
+
+    world &w = *g->get_active_world();
+    // Far away from anything the other tests could generate
+    const point_abs_om p( -4000, -4000 );
+
+    w.start_save_tx();
+    w.write_overmap( p, []( std::ostream & fout ) {
+        fout << "first";
+    } );
+    // Reads during the transaction see the data written in it
+    CHECK( w.overmap_exists( p ) );
+    CHECK( read_overmap_data( w, p ) == "first" );
+    w.write_overmap( p, []( std::ostream & fout ) {
+        fout << "second";
+    } );
+    CHECK( read_overmap_data( w, p ) == "second" );
+    w.commit_save_tx();
+
+    // Reads right after the commit may be served while data is still being stored
+    CHECK( read_overmap_data( w, p ) == "second" );
+
+    // Writes outside of a transaction must not be overwritten by the stored save
+    w.write_overmap( p, []( std::ostream & fout ) {
+        fout << "third";
+    } );
+    CHECK( read_overmap_data( w, p ) == "third" );
+
+    // Starting the next save waits for the previous one, so this reads from the database
+    w.start_save_tx();
+    CHECK( read_overmap_data( w, p ) == "third" );
+    w.commit_save_tx();
+}
+
+static std::string read_map_quad_data( const world &w, const tripoint &om_addr )
+{
+    std::string data;
+    w.read_map_quad( om_addr, [&]( JsonIn & jsin ) {
+        data = jsin.get_string();
+    } );
+    return data;
+}
+
+TEST_CASE( "world_prefetched_map_quads_are_not_stale", "[world][save]" )
+{
+    world &w = *g->get_active_world();
+    const tripoint om_addr( -8000, -8000, 0 );
+
+    w.write_map_quad( om_addr, []( JsonOut & jsout ) {
+        jsout.write( "first" );
+    } );
+    w.prefetch_map_quads( { om_addr } );
+    CHECK( read_map_quad_data( w, om_addr ) == "first" );
+
+    // A write after the prefetch replaces the data read ahead of time
+    w.prefetch_map_quads( { om_addr } );
+    w.write_map_quad( om_addr, []( JsonOut & jsout ) {
+        jsout.write( "second" );
+    } );
+    CHECK( read_map_quad_data( w, om_addr ) == "second" );
+
+    // Quads that were never written are reported as missing
+    const tripoint missing( -8002, -8000, 0 );
+    w.prefetch_map_quads( { missing } );
+    CHECK_FALSE( w.read_map_quad( missing, []( JsonIn & ) {} ) );
+}
@@ -0,0 +1,144 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cata_utility.h"
+#include "clzones.h"
+#include "item.h"
+#include "line.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const zone_type_id zone_type_LOOT_FOOD( "LOOT_FOOD" );
+static const zone_type_id zone_type_LOOT_TOOLS( "LOOT_TOOLS" );
+
+namespace
+{
+
+struct test_zone {
+    zone_type_id type;
+    tripoint start;
+    tripoint end;
+};
+
+// Lays out a base of many small zones of a few loot types, on two z-levels
+std::vector<test_zone> add_test_zones( zone_manager &mgr, int count )
+{
+    static const std::vector<zone_type_id> types = {
+        zone_type_id( "LOOT_FOOD" ), zone_type_id( "LOOT_TOOLS" ), zone_type_id( "LOOT_CLOTHING" ),
+        zone_type_id( "LOOT_WOOD" ), zone_type_id( "LOOT_AMMO" ), zone_type_id( "LOOT_DRUGS" ),
+        zone_type_id( "LOOT_DUMP" )
+    };
+    std::vector<test_zone> added;
+    for( int i = 0; i < count; i++ ) {
+        const tripoint start( rng( 0, 100 ), rng( 0, 100 ), rng( 0, 1 ) );
+        const tripoint end = start + tripoint( rng( 0, 4 ), rng( 0, 4 ), 0 );
+        const zone_type_id &type = types[i % types.size()];
+        mgr.add( "test zone", type, faction_id( "your_followers" ), false, true, start, end );
+        added.push_back( { type, start, end } );
+    }
+    return added;
+}
+
+std::unordered_set<tripoint> brute_force_near( const std::vector<test_zone> &zones,
+        const zone_type_id &type, const tripoint &where, int range )
+{
+    std::unordered_set<tripoint> result;
+    for( const test_zone &zone : zones ) {
+        if( zone.type != type || where.z < zone.start.z || where.z > zone.end.z ) {
+            continue;
+        }
+        for( int x = zone.start.x; x <= zone.end.x; x++ ) {
+            for( int y = zone.start.y; y <= zone.end.y; y++ ) {
+                const tripoint p( x, y, where.z );
+                if( square_dist( p, where ) <= range ) {
+                    result.insert( p );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE( "zone_lookups_match_covered_squares", "[zones]" )
+{
+    clear_all_state();
+    zone_manager::reset_manager();
+    zone_manager &mgr = zone_manager::get_manager();
+    const std::vector<test_zone> zones = add_test_zones( mgr, 150 );
+
+    for( int i = 0; i < 200; i++ ) {
+        const tripoint where( rng( -20, 120 ), rng( -20, 120 ), rng( 0, 1 ) );
+        const int range = rng( 0, 30 );
+        for( const zone_type_id &type : {
+                 zone_type_LOOT_FOOD, zone_type_LOOT_TOOLS
+             } ) {
+            CAPTURE( where, range, type.str() );
+            const std::unordered_set<tripoint> expected = brute_force_near( zones, type, where, range );
+            CHECK( mgr.get_near( type, where, range ) == expected );
+            CHECK( mgr.has_near( type, where, range ) == !expected.empty() );
+            CHECK( mgr.has( type, where ) == brute_force_near( zones, type, where, 0 ).contains( where ) );
+
+            const std::optional<tripoint> nearest = mgr.get_nearest( type, where, range );
+            std::optional<int> expected_dist;
+            for( const test_zone &zone : zones ) {
+                if( zone.type != type ) {
+                    continue;
+                }
+                const tripoint closest( clamp( where.x, zone.start.x, zone.end.x ),
+                                        clamp( where.y, zone.start.y, zone.end.y ),
+                                        clamp( where.z, zone.start.z, zone.end.z ) );
+                const int dist = square_dist( closest, where );
+                if( dist <= range && ( !expected_dist || dist < *expected_dist ) ) {
+                    expected_dist = dist;
+                }
+            }
+            REQUIRE( nearest.has_value() == expected_dist.has_value() );
+            if( nearest ) {
+                CHECK( square_dist( *nearest, where ) == *expected_dist );
+                CHECK( mgr.has( type, *nearest ) );
+            }
+        }
+    }
+    zone_manager::reset_manager();
+}
+
+TEST_CASE( "zone_loot_sorting_benchmark", "[zones][benchmark][.]" )
+{
+    clear_all_state();
+    zone_manager::reset_manager();
+    zone_manager &mgr = zone_manager::get_manager();
+    add_test_zones( mgr, 300 );
+
+    const std::vector<std::string> item_types = {
+        "rock", "hammer", "jeans", "2x4", "aspirin", "can_beans"
+    };
+    std::vector<detached_ptr<item>> pile;
+    for( int i = 0; i < 1000; i++ ) {
+        pile.push_back( item::spawn( item_types[i % item_types.size()] ) );
+    }
+    const tripoint src( 50, 50, 0 );
+
+    // The zone queries activity_on_turn_move_loot makes for each item of a pile
+    BENCHMARK( "sort a 1000 item pile across 300 zones" ) {
+        size_t destinations = 0;
+        for( const detached_ptr<item> &it : pile ) {
+            const zone_type_id id = mgr.get_near_zone_type_for_item( *it, src, 60 );
+            if( mgr.has( id, src ) ) {
+                continue;
+            }
+            destinations += mgr.get_near( id, src, 60, &*it ).size();
+        }
+        return destinations;
+    };
+    zone_manager::reset_manager();
+}